@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "core/util/include/dense_gemm.hpp"
+#include "core/util/include/thread_pool.hpp"
+
+namespace {
+
+template <typename Value>
+std::vector<Value> NaiveMultiply(const std::vector<Value> &first, const std::vector<Value> &second, int rows,
+                                 int inner, int cols) {
+  std::vector<Value> result(static_cast<size_t>(rows) * cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      Value sum = 0;
+      for (int k = 0; k < inner; k++) sum += first[(i * inner) + k] * second[(k * cols) + j];
+      result[(i * cols) + j] = sum;
+    }
+  }
+  return result;
+}
+
+std::vector<double> RandomMatrix(int rows, int cols, unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  std::vector<double> data(static_cast<size_t>(rows) * cols);
+  for (auto &value : data) value = distribution(generator);
+  return data;
+}
+
+}  // namespace
+
+TEST(dense_gemm_tests, matches_naive_loop_bit_for_bit) {
+  // Shapes with ragged row panels, ragged strips and more than one depth and column block.
+  for (auto [rows, inner, cols] : {std::array{1, 1, 1}, std::array{7, 13, 9}, std::array{67, 300, 141}}) {
+    auto first = RandomMatrix(rows, inner, 1);
+    auto second = RandomMatrix(inner, cols, 2);
+    EXPECT_EQ(ppc::util::MultiplyDense(first, second, rows, inner, cols),
+              NaiveMultiply(first, second, rows, inner, cols));
+  }
+}
+
+TEST(dense_gemm_tests, pool_gives_serial_result) {
+  ppc::util::ThreadPool pool(4);
+  auto first = RandomMatrix(150, 90, 3);
+  auto second = RandomMatrix(90, 70, 4);
+  EXPECT_EQ(ppc::util::MultiplyDense(first, second, 150, 90, 70, &pool),
+            ppc::util::MultiplyDense(first, second, 150, 90, 70));
+}
+
+TEST(dense_gemm_tests, multiplies_integers) {
+  std::vector<int> first(5 * 6);
+  std::vector<int> second(6 * 11);
+  for (size_t i = 0; i < first.size(); i++) first[i] = static_cast<int>(i % 5) - 2;
+  for (size_t i = 0; i < second.size(); i++) second[i] = static_cast<int>(i % 7) - 3;
+  EXPECT_EQ(ppc::util::MultiplyDense(first, second, 5, 6, 11), NaiveMultiply(first, second, 5, 6, 11));
+}
+
+TEST(dense_gemm_tests, rejects_mismatched_sizes) {
+  std::vector<double> first(6);
+  std::vector<double> second(6);
+  EXPECT_THROW(ppc::util::MultiplyDense(first, second, 2, 3, 3), std::invalid_argument);
+  EXPECT_EQ(ppc::util::MultiplyDense(first, second, 2, 3, 2).size(), 4U);
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "core/util/include/thread_pool.hpp"
+
+TEST(thread_pool_tests, runs_every_index_once) {
+  ppc::util::ThreadPool pool(4);
+  EXPECT_EQ(pool.GetThreadsCount(), 4);
+
+  std::vector<int> hits(1000, 0);
+  pool.ParallelFor(static_cast<int>(hits.size()), [&](int index) { hits[index]++; });
+  EXPECT_EQ(std::accumulate(hits.begin(), hits.end(), 0), 1000);
+  EXPECT_EQ(*std::ranges::max_element(hits), 1);
+}
+
+TEST(thread_pool_tests, single_thread_runs_inline) {
+  ppc::util::ThreadPool pool(1);
+  auto caller = std::this_thread::get_id();
+  bool inline_only = true;
+  pool.ParallelFor(16, [&](int) { inline_only = inline_only && std::this_thread::get_id() == caller; });
+  EXPECT_TRUE(inline_only);
+}
+
+TEST(thread_pool_tests, uneven_jobs_are_stolen) {
+  ppc::util::ThreadPool pool(4);
+  std::atomic<int> done{0};
+  // All the slow jobs sit in the first worker's run; the others can only finish early by stealing them.
+  pool.ParallelFor(64, [&](int index) {
+    if (index < 16) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    done++;
+  });
+  EXPECT_EQ(done.load(), 64);
+}
+
+TEST(thread_pool_tests, rethrows_job_exception) {
+  ppc::util::ThreadPool pool(3);
+  EXPECT_THROW(pool.ParallelFor(10,
+                                [](int index) {
+                                  if (index == 7) throw std::runtime_error("job failed");
+                                }),
+               std::runtime_error);
+
+  // The pool stays usable after a failed batch.
+  std::atomic<int> done{0};
+  pool.ParallelFor(10, [&](int) { done++; });
+  EXPECT_EQ(done.load(), 10);
+}
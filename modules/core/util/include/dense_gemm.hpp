@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "core/util/include/thread_pool.hpp"
+
+namespace ppc::util {
+
+// Rows of C one micro-kernel call produces; together with kGemmMicroColumns they form the tile of C kept in
+// registers while the kernel walks the depth.
+constexpr int kGemmMicroRows = 8;
+// Columns of C per micro-kernel call. B is packed into strips this wide so the kernel reads it contiguously and the
+// innermost loop over them vectorizes.
+constexpr int kGemmMicroColumns = 4;
+// Depth of one pass over a block of strips and columns of one such block, sized so the strips of a block (256 KiB of
+// doubles) stay in L2 while every row of A sweeps over them.
+constexpr int kGemmDepthBlock = 256;
+constexpr int kGemmColumnBlock = 128;
+// Rows of C per parallel job.
+constexpr int kGemmRowBlock = 64;
+
+// C = A * B for row-major A (rows x inner) and B (inner x cols), returned row-major. Meant as the reference result
+// tests compare against: every entry of C is summed over k in ascending order starting from zero, exactly as the
+// naive triple loop does, so results match it bit for bit. Runs on pool when one is given, serially otherwise.
+// Throws std::invalid_argument when the operand sizes do not match the dimensions.
+template <typename Value>
+std::vector<Value> MultiplyDense(const std::vector<Value> &first, const std::vector<Value> &second, int rows,
+                                 int inner, int cols, ThreadPool *pool = nullptr);
+
+namespace detail {
+
+// B as ceil(cols / kGemmMicroColumns) strips, each an inner x kGemmMicroColumns row-major block of consecutive
+// columns; the last strip is padded with zeros.
+template <typename Value>
+std::vector<Value> PackGemmStrips(const std::vector<Value> &second, int inner, int cols) {
+  int strips_count = (cols + kGemmMicroColumns - 1) / kGemmMicroColumns;
+  std::vector<Value> strips(static_cast<size_t>(strips_count) * inner * kGemmMicroColumns, Value{0});
+  for (int k = 0; k < inner; k++) {
+    const Value *row = second.data() + (static_cast<size_t>(k) * cols);
+    for (int j = 0; j < cols; j++) {
+      size_t strip = static_cast<size_t>(j / kGemmMicroColumns);
+      strips[(((strip * inner) + k) * kGemmMicroColumns) + (j % kGemmMicroColumns)] = row[j];
+    }
+  }
+  return strips;
+}
+
+// Adds the first depth columns of a Rows-row panel of A, read from first with row stride inner, times the matching
+// rows of a strip into the Rows x width tile of C at result, whose row stride is cols. The tile is loaded into the
+// accumulators first, so each entry keeps summing in the order of the naive loop.
+template <int Rows, typename Value>
+void GemmMicroKernel(const Value *first, int inner, const Value *strip, int depth, int width, Value *result,
+                     int cols) {
+  std::array<std::array<Value, kGemmMicroColumns>, Rows> sums{};
+  for (int r = 0; r < Rows; r++) std::copy_n(result + (static_cast<size_t>(r) * cols), width, sums[r].begin());
+  for (int k = 0; k < depth; k++) {
+    const Value *b = strip + (static_cast<size_t>(k) * kGemmMicroColumns);
+    for (int r = 0; r < Rows; r++) {
+      const Value a = first[(static_cast<size_t>(r) * inner) + k];
+      for (int v = 0; v < kGemmMicroColumns; v++) sums[r][v] += a * b[v];
+    }
+  }
+  for (int r = 0; r < Rows; r++) std::copy_n(sums[r].begin(), width, result + (static_cast<size_t>(r) * cols));
+}
+
+// GemmMicroKernel for the height rows left at the bottom of a row block, height <= Rows.
+template <int Rows, typename Value>
+void GemmTile(int height, const Value *first, int inner, const Value *strip, int depth, int width, Value *result,
+              int cols) {
+  if constexpr (Rows > 1) {
+    if (height < Rows) {
+      GemmTile<Rows - 1>(height, first, inner, strip, depth, width, result, cols);
+      return;
+    }
+  }
+  GemmMicroKernel<Rows>(first, inner, strip, depth, width, result, cols);
+}
+
+// Rows [first_row, last_row) of C.
+template <typename Value>
+void MultiplyDenseRows(const std::vector<Value> &first, const std::vector<Value> &strips, int inner, int cols,
+                       int first_row, int last_row, Value *result) {
+  constexpr int kStripsPerBlock = kGemmColumnBlock / kGemmMicroColumns;
+  int strips_count = (cols + kGemmMicroColumns - 1) / kGemmMicroColumns;
+  for (int block = 0; block < strips_count; block += kStripsPerBlock) {
+    int last_strip = std::min(strips_count, block + kStripsPerBlock);
+    for (int k = 0; k < inner; k += kGemmDepthBlock) {
+      int depth = std::min(kGemmDepthBlock, inner - k);
+      for (int row = first_row; row < last_row; row += kGemmMicroRows) {
+        const Value *a = first.data() + (static_cast<size_t>(row) * inner) + k;
+        for (int strip = block; strip < last_strip; strip++) {
+          const Value *b = strips.data() + (((static_cast<size_t>(strip) * inner) + k) * kGemmMicroColumns);
+          int column = strip * kGemmMicroColumns;
+          int width = std::min(kGemmMicroColumns, cols - column);
+          Value *c = result + (static_cast<size_t>(row) * cols) + column;
+          GemmTile<kGemmMicroRows>(std::min(kGemmMicroRows, last_row - row), a, inner, b, depth, width, c, cols);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace detail
+
+template <typename Value>
+std::vector<Value> MultiplyDense(const std::vector<Value> &first, const std::vector<Value> &second, int rows,
+                                 int inner, int cols, ThreadPool *pool) {
+  if (rows < 0 || inner < 0 || cols < 0 || first.size() != static_cast<size_t>(rows) * inner ||
+      second.size() != static_cast<size_t>(inner) * cols) {
+    throw std::invalid_argument("Matrix dimensions do not match for multiplication");
+  }
+  std::vector<Value> result(static_cast<size_t>(rows) * cols, Value{0});
+  if (rows == 0 || cols == 0 || inner == 0) return result;
+
+  auto strips = detail::PackGemmStrips(second, inner, cols);
+  int blocks_count = (rows + kGemmRowBlock - 1) / kGemmRowBlock;
+  auto multiply_block = [&](int block) {
+    int first_row = block * kGemmRowBlock;
+    detail::MultiplyDenseRows(first, strips, inner, cols, first_row, std::min(rows, first_row + kGemmRowBlock),
+                              result.data());
+  };
+  if (pool == nullptr) {
+    for (int block = 0; block < blocks_count; block++) multiply_block(block);
+  } else {
+    pool->ParallelFor(blocks_count, multiply_block);
+  }
+  return result;
+}
+
+}  // namespace ppc::util
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ppc::util {
+
+// Work-stealing pool on std::thread. Every worker owns a deque: it pops its own jobs from the back and steals
+// from the front of the others' when it runs dry. The thread calling ParallelFor takes part as worker 0, so a
+// pool of n threads starts n - 1 of its own and a pool of one runs everything inline.
+class ThreadPool {
+ public:
+  explicit ThreadPool(int threads_count);
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ~ThreadPool();
+
+  [[nodiscard]] int GetThreadsCount() const { return static_cast<int>(queues_.size()); }
+
+  // Runs body(index) for every index in [0, count) and returns once all of them are done. Indices are dealt
+  // to the workers in contiguous runs; the first exception thrown by body is rethrown here.
+  void ParallelFor(int count, const std::function<void(int)> &body);
+
+  // Process-wide pool sized by GetPPCNumThreads() when first used.
+  static ThreadPool &Shared();
+
+ private:
+  using Job = std::function<void()>;
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+  };
+
+  bool TryRunJob(size_t self);
+  void WorkerLoop(size_t self);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<size_t> queued_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  bool stopping_ = false;
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,116 @@
+#include "core/util/include/thread_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "core/util/include/util.hpp"
+
+namespace {
+
+// Completion state of one ParallelFor call, shared with its jobs so that it outlives the last of them.
+struct Batch {
+  std::mutex mutex;
+  std::condition_variable done;
+  int pending = 0;
+  std::exception_ptr error;
+};
+
+}  // namespace
+
+ppc::util::ThreadPool::ThreadPool(int threads_count) {
+  threads_count = std::max(1, threads_count);
+  for (int i = 0; i < threads_count; i++) queues_.push_back(std::make_unique<WorkerQueue>());
+  for (int i = 1; i < threads_count; i++) workers_.emplace_back([this, i] { WorkerLoop(i); });
+}
+
+ppc::util::ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(sleep_mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (auto &worker : workers_) worker.join();
+}
+
+ppc::util::ThreadPool &ppc::util::ThreadPool::Shared() {
+  static ThreadPool pool(GetPPCNumThreads());
+  return pool;
+}
+
+void ppc::util::ThreadPool::ParallelFor(int count, const std::function<void(int)> &body) {
+  if (count <= 0) return;
+  if (workers_.empty() || count == 1) {
+    for (int index = 0; index < count; index++) body(index);
+    return;
+  }
+
+  auto batch = std::make_shared<Batch>();
+  batch->pending = count;
+  size_t queues_count = queues_.size();
+  for (size_t queue = 0; queue < queues_count; queue++) {
+    int begin = static_cast<int>(static_cast<long long>(count) * queue / queues_count);
+    int end = static_cast<int>(static_cast<long long>(count) * (queue + 1) / queues_count);
+    // Counted before they are published, so that a worker taking one at once never drives queued_ below zero.
+    {
+      std::lock_guard lock(sleep_mutex_);
+      queued_ += end - begin;
+    }
+    std::lock_guard lock(queues_[queue]->mutex);
+    for (int index = begin; index < end; index++) {
+      queues_[queue]->jobs.emplace_back([batch, &body, index] {
+        try {
+          body(index);
+        } catch (...) {
+          std::lock_guard error_lock(batch->mutex);
+          if (!batch->error) batch->error = std::current_exception();
+        }
+        std::lock_guard done_lock(batch->mutex);
+        if (--batch->pending == 0) batch->done.notify_all();
+      });
+    }
+  }
+  wake_.notify_all();
+
+  while (TryRunJob(0)) {
+  }
+  std::unique_lock lock(batch->mutex);
+  batch->done.wait(lock, [&] { return batch->pending == 0; });
+  if (batch->error) std::rethrow_exception(batch->error);
+}
+
+bool ppc::util::ThreadPool::TryRunJob(size_t self) {
+  Job job;
+  {
+    std::lock_guard lock(queues_[self]->mutex);
+    if (!queues_[self]->jobs.empty()) {
+      job = std::move(queues_[self]->jobs.back());
+      queues_[self]->jobs.pop_back();
+    }
+  }
+  for (size_t offset = 1; !job && offset < queues_.size(); offset++) {
+    auto &victim = *queues_[(self + offset) % queues_.size()];
+    std::lock_guard lock(victim.mutex);
+    if (!victim.jobs.empty()) {
+      job = std::move(victim.jobs.front());
+      victim.jobs.pop_front();
+    }
+  }
+  if (!job) return false;
+  queued_--;
+  job();
+  return true;
+}
+
+void ppc::util::ThreadPool::WorkerLoop(size_t self) {
+  while (true) {
+    if (TryRunJob(self)) continue;
+    std::unique_lock lock(sleep_mutex_);
+    wake_.wait(lock, [&] { return stopping_ || queued_ > 0; });
+    if (stopping_ && queued_ == 0) return;
+  }
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "sparse/matrix/include/csr_matrix.hpp"
+#include "sparse/matrix/include/execution.hpp"
+#include "sparse/matrix/include/execution_stl.hpp"
+#include "sparse/matrix/include/generators.hpp"
+#include "sparse/matrix/include/sparse_matrix.hpp"
+#include "sparse/matrix/include/spmv.hpp"
+
+using ppc::sparse::ThreadPoolPolicy;
+
+TEST(sparse_execution, parallel_for_ranges_covers_every_index_once) {
+  std::vector<std::atomic<int>> hits(1001);
+  ppc::sparse::ParallelForRanges<ThreadPoolPolicy>(hits.size(), [&](size_t first, size_t last) {
+    for (size_t i = first; i < last; i++) hits[i]++;
+  });
+  for (const auto& hit : hits) EXPECT_EQ(hit.load(), 1);
+}
+
+TEST(sparse_execution, parallel_for_rethrows_from_body) {
+  EXPECT_THROW(ThreadPoolPolicy::ParallelFor(8,
+                                             [](int index) {
+                                               if (index == 5) throw std::runtime_error("block failed");
+                                             }),
+               std::runtime_error);
+}
+
+TEST(sparse_matrix_module, rebinding_policy_shares_arrays) {
+  auto matrix = ppc::sparse::GenerateUniform(40, 30, 0.2, 7);
+  ppc::sparse::BasicSparseMatrix<double, int, ThreadPoolPolicy> rebound(matrix);
+  EXPECT_EQ(rebound.GetValues().data(), matrix.GetValues().data());
+  EXPECT_EQ(rebound.GetRowIndices().data(), matrix.GetRowIndices().data());
+  EXPECT_EQ(rebound.GetCumulativeElements().data(), matrix.GetCumulativeElements().data());
+}
+
+TEST(sparse_matrix_module, sequential_multiply_matches_dense_oracle) {
+  auto first = ppc::sparse::GenerateUniform(30, 40, 0.2, 11);
+  auto second = ppc::sparse::GenerateUniform(40, 25, 0.2, 12);
+  auto expected = ppc::sparse::MultiplyMatrices(ppc::sparse::FromSparseMatrix(first), 30, 40,
+                                                ppc::sparse::FromSparseMatrix(second), 40, 25);
+  EXPECT_EQ(ppc::sparse::FromSparseMatrix(first * second), expected);
+}
+
+TEST(sparse_matrix_module, policies_give_identical_results) {
+  auto first = ppc::sparse::GenerateRMat<double, int, ThreadPoolPolicy>(7, 0.05, 3);
+  auto second = ppc::sparse::GenerateRMat<double, int, ThreadPoolPolicy>(7, 0.05, 4);
+  auto sequential_first = ppc::sparse::GenerateRMat(7, 0.05, 3);
+  auto sequential_second = ppc::sparse::GenerateRMat(7, 0.05, 4);
+  EXPECT_EQ(ppc::sparse::FromSparseMatrix(first), ppc::sparse::FromSparseMatrix(sequential_first));
+
+  auto product = first * second;
+  auto sequential_product = sequential_first * sequential_second;
+  EXPECT_TRUE(std::ranges::equal(product.GetValues(), sequential_product.GetValues()));
+  EXPECT_TRUE(std::ranges::equal(product.GetRowIndices(), sequential_product.GetRowIndices()));
+  EXPECT_TRUE(std::ranges::equal(product.GetCumulativeElements(), sequential_product.GetCumulativeElements()));
+}
+
+TEST(sparse_matrix_module, spmm_layouts_agree_under_thread_pool) {
+  auto matrix = ppc::sparse::GenerateUniform<double, int, ThreadPoolPolicy>(50, 60, 0.1, 5);
+  std::vector<double> block(60 * 3);
+  for (size_t i = 0; i < block.size(); i++) block[i] = static_cast<double>(i % 7);
+  auto expected = ppc::sparse::MultiplyMatrices(ppc::sparse::FromSparseMatrix(matrix), 50, 60, block, 60, 3);
+
+  std::vector<double> by_columns(50 * 3);
+  std::vector<double> by_rows(50 * 3);
+  ppc::sparse::MultiplyCcs(matrix, block.data(), 3, by_columns.data());
+  ppc::sparse::MultiplyCsr(decltype(matrix)::ComputeTranspose(matrix), block.data(), 3, by_rows.data());
+  EXPECT_EQ(by_columns, expected);
+  EXPECT_EQ(by_rows, expected);
+}
+
+TEST(sparse_matrix_module, csr_multiply_matches_ccs_under_thread_pool) {
+  auto first = ppc::sparse::GenerateUniform<double, int, ThreadPoolPolicy>(45, 70, 0.1, 21);
+  auto second = ppc::sparse::GenerateUniform<double, int, ThreadPoolPolicy>(70, 35, 0.1, 22);
+  auto product = ppc::sparse::BasicCsrMatrix<double, int, ThreadPoolPolicy>::FromCcs(first) *
+                 ppc::sparse::BasicCsrMatrix<double, int, ThreadPoolPolicy>::FromCcs(second);
+  EXPECT_EQ(product.GetRowCount(), 45);
+  EXPECT_EQ(product.GetColumnCount(), 35);
+  EXPECT_EQ(ppc::sparse::FromCsrMatrix(product), ppc::sparse::FromSparseMatrix(first * second));
+}
+
+TEST(sparse_matrix_module, drop_policy_prunes_alike_under_thread_pool) {
+  auto first = ppc::sparse::GenerateRMat<double, int, ThreadPoolPolicy>(7, 0.05, 31);
+  auto second = ppc::sparse::GenerateRMat<double, int, ThreadPoolPolicy>(7, 0.05, 32);
+  const ppc::sparse::DropPolicy drop{.relative = 0.1, .top_k = 3};
+  auto product = first.Multiply(second, drop);
+  auto sequential_product = ppc::sparse::BasicSparseMatrix<double, int>(first).Multiply(
+      ppc::sparse::BasicSparseMatrix<double, int>(second), drop);
+  EXPECT_TRUE(std::ranges::equal(product.GetValues(), sequential_product.GetValues()));
+  EXPECT_TRUE(std::ranges::equal(product.GetRowIndices(), sequential_product.GetRowIndices()));
+  auto lengths = ppc::sparse::detail::ColumnLengths(product.GetCumulativeElements());
+  EXPECT_LE(*std::ranges::max_element(lengths), 3U);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "sparse/matrix/include/sparse_matrix.hpp"
+
+namespace ppc::sparse {
+
+// On-disk layout of a binary CCS file: this header followed by the values, row indices and cumulative column
+// counts, each starting at a kBinaryCCSAlignment-aligned offset and stored in native byte order. Values are always
+// doubles; row indices and counts take index_bytes each, 4 for int and 8 for std::int64_t.
+struct BinaryCCSHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t index_bytes;
+  int64_t rows_count;
+  int64_t columns_count;
+  int64_t nnz;
+  uint64_t values_offset;
+  uint64_t row_indices_offset;
+  uint64_t cumulative_offset;
+};
+static_assert(sizeof(BinaryCCSHeader) == 64);
+
+constexpr char kBinaryCCSMagic[8] = {'P', 'P', 'C', 'C', 'C', 'S', '0', '1'};
+constexpr uint32_t kBinaryCCSVersion = 1;
+constexpr size_t kBinaryCCSAlignment = 64;
+
+// Writes the indices with the width of Index. Defined for int and std::int64_t.
+template <typename Index>
+void WriteBinaryCCS(const std::string& path, const BasicSparseMatrix<double, Index>& matrix);
+template <typename Index, typename Policy>
+void WriteBinaryCCS(const std::string& path, const BasicSparseMatrix<double, Index, Policy>& matrix) {
+  WriteBinaryCCS(path, BasicSparseMatrix<double, Index>(matrix));
+}
+// Maps the file read-only and returns a matrix viewing the mapped arrays directly; the mapping is released when
+// the last copy of the matrix goes away. Nothing is copied, but one pass checks that the cumulative counts never
+// decrease and end at nnz and that every column's row indices are in range and increasing. Since the arrays are not
+// converted, Index must have the width the file was written with.
+// Throws std::runtime_error on unreadable, truncated or malformed files and on an index width other than Index's.
+// Defined for int and std::int64_t.
+template <typename Index = int>
+BasicSparseMatrix<double, Index> MapBinaryCCS(const std::string& path);
+
+}  // namespace ppc::sparse
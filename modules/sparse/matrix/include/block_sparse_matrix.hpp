@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "sparse/matrix/include/execution.hpp"
+#include "sparse/matrix/include/sparse_matrix.hpp"
+
+namespace ppc::sparse {
+
+template <typename Value, typename Index, typename Policy = SequentialPolicy>
+class BasicBlockSparseMatrix;
+
+using BlockSparseMatrix = BasicBlockSparseMatrix<double, int>;
+
+// Block compressed sparse column storage. The matrix is cut into block_size x block_size tiles and only the tiles
+// holding a nonzero are kept, each as block_size^2 column-major values. Block rows and cumulative block counts index
+// the tiles the way row indices and cumulative counts index the entries of CCS, so one index covers a whole tile.
+// Dimensions that are not a multiple of block_size are padded with zeros in the last block row and column.
+template <typename Value, typename Index, typename Policy>
+class BasicBlockSparseMatrix {
+  using Matrix = BasicSparseMatrix<Value, Index, Policy>;
+
+  int rows_count_ = 0;
+  int cols_count_ = 0;
+  int block_size_ = 1;
+  std::vector<Value> values_;
+  std::vector<Index> block_rows_;
+  std::vector<Index> cumulative_blocks_;
+
+  // Block Gustavson column kernel for tiles of Size, or of block_size_ when Size is 0: sums the tile products of
+  // C(:, col) in tiles, slots mapping every block row to its tile, and appends the tiles that keep an entry above
+  // kThreshold in block row order. Returns the number appended.
+  template <int Size>
+  int MultiplyColumn(const BasicBlockSparseMatrix& other, int col, std::vector<int>& slots, std::vector<int>& pattern,
+                     std::vector<Value>& tiles, std::vector<Value>& values, std::vector<Index>& rows) const;
+  template <int Size>
+  BasicBlockSparseMatrix MultiplyBlocks(const BasicBlockSparseMatrix& other) const;
+
+ public:
+  using value_type = Value;
+  using index_type = Index;
+  using policy_type = Policy;
+
+  BasicBlockSparseMatrix() = default;
+  BasicBlockSparseMatrix(int rows, int columns, int block_size, std::vector<Value> values,
+                         std::vector<Index> block_rows, std::vector<Index> cumulative_blocks)
+      : rows_count_(rows),
+        cols_count_(columns),
+        block_size_(block_size),
+        values_(std::move(values)),
+        block_rows_(std::move(block_rows)),
+        cumulative_blocks_(std::move(cumulative_blocks)) {}
+
+  // Gathers the entries of matrix into tiles. Throws std::invalid_argument unless block_size is positive.
+  static BasicBlockSparseMatrix FromSparse(const Matrix& matrix, int block_size);
+  // Back to CCS, leaving out the zeros stored inside the tiles.
+  Matrix ToSparse() const;
+
+  std::span<const Value> GetValues() const noexcept { return values_; }
+  std::span<const Index> GetBlockRows() const noexcept { return block_rows_; }
+  std::span<const Index> GetCumulativeBlocks() const noexcept { return cumulative_blocks_; }
+  int GetRowCount() const noexcept { return rows_count_; }
+  int GetColumnCount() const noexcept { return cols_count_; }
+  int GetBlockSize() const noexcept { return block_size_; }
+  int GetBlockRowCount() const noexcept { return (rows_count_ + block_size_ - 1) / block_size_; }
+  int GetBlockColumnCount() const noexcept { return (cols_count_ + block_size_ - 1) / block_size_; }
+
+  // Block Gustavson product: every tile of C(:, J) sums the dense tile products A(I, K) * B(K, J). Tiles of 2, 3, 4
+  // and 6 run kernels unrolled for their size, other sizes a generic loop; output tiles with no entry above
+  // kThreshold are dropped. Throws std::invalid_argument unless the dimensions and block sizes match.
+  BasicBlockSparseMatrix Multiply(const BasicBlockSparseMatrix& other) const;
+  BasicBlockSparseMatrix operator*(const BasicBlockSparseMatrix& other) const { return Multiply(other); }
+};
+
+namespace detail {
+
+// result += first * second for column-major tiles of Size, a compile-time constant the loops unroll on, or of size
+// when Size is 0. The innermost loop runs down a column of first and result, so it vectorizes for either.
+template <int Size, typename Value>
+void MultiplyTile(const Value* first, const Value* second, Value* result, int size) {
+  const int n = Size != 0 ? Size : size;
+  for (int col = 0; col < n; col++) {
+    for (int inner = 0; inner < n; inner++) {
+      Value factor = second[inner + (col * n)];
+      for (int row = 0; row < n; row++) result[row + (col * n)] += first[row + (inner * n)] * factor;
+    }
+  }
+}
+
+}  // namespace detail
+
+template <typename Value, typename Index, typename Policy>
+BasicBlockSparseMatrix<Value, Index, Policy> BasicBlockSparseMatrix<Value, Index, Policy>::FromSparse(
+    const Matrix& matrix, int block_size) {
+  if (block_size <= 0) throw std::invalid_argument("Block size must be positive");
+  BasicBlockSparseMatrix result;
+  result.rows_count_ = matrix.GetRowCount();
+  result.cols_count_ = matrix.GetColumnCount();
+  result.block_size_ = block_size;
+  auto tile_size = static_cast<size_t>(block_size) * block_size;
+
+  auto sums = matrix.GetCumulativeElements();
+  auto rows = matrix.GetRowIndices();
+  auto values = matrix.GetValues();
+  std::vector<int> slots(result.GetBlockRowCount(), -1);
+  std::vector<int> pattern;
+  std::vector<Value> tiles;
+  for (int block_col = 0; block_col < result.GetBlockColumnCount(); block_col++) {
+    pattern.clear();
+    tiles.clear();
+    int first_col = block_col * block_size;
+    int last_col = std::min(first_col + block_size, result.cols_count_);
+    for (int col = first_col; col < last_col; col++) {
+      for (Index element = col == 0 ? 0 : sums[col - 1]; element < sums[col]; element++) {
+        auto row = static_cast<int>(rows[element]);
+        int block_row = row / block_size;
+        if (slots[block_row] < 0) {
+          slots[block_row] = static_cast<int>(pattern.size());
+          pattern.push_back(block_row);
+          tiles.resize(tiles.size() + tile_size, 0);
+        }
+        auto offset = (static_cast<size_t>(slots[block_row]) * tile_size) + (row % block_size) +
+                      (static_cast<size_t>(col - first_col) * block_size);
+        tiles[offset] = values[element];
+      }
+    }
+    std::ranges::sort(pattern);
+    for (int block_row : pattern) {
+      auto tile = tiles.begin() + static_cast<std::ptrdiff_t>(slots[block_row] * tile_size);
+      result.values_.insert(result.values_.end(), tile, tile + static_cast<std::ptrdiff_t>(tile_size));
+      result.block_rows_.push_back(block_row);
+      slots[block_row] = -1;
+    }
+    result.cumulative_blocks_.push_back(static_cast<Index>(result.block_rows_.size()));
+  }
+  return result;
+}
+
+template <typename Value, typename Index, typename Policy>
+BasicSparseMatrix<Value, Index, Policy> BasicBlockSparseMatrix<Value, Index, Policy>::ToSparse() const {
+  auto tile_size = static_cast<size_t>(block_size_) * block_size_;
+  std::vector<Value> values;
+  std::vector<Index> rows;
+  std::vector<Index> cumulative(cols_count_, 0);
+  for (int col = 0; col < cols_count_; col++) {
+    int block_col = col / block_size_;
+    Index first_block = block_col == 0 ? 0 : cumulative_blocks_[block_col - 1];
+    size_t column_offset = static_cast<size_t>(col % block_size_) * block_size_;
+    for (Index block = first_block; block < cumulative_blocks_[block_col]; block++) {
+      const Value* tile = values_.data() + (static_cast<size_t>(block) * tile_size) + column_offset;
+      int first_row = static_cast<int>(block_rows_[block]) * block_size_;
+      int rows_in_tile = std::min(block_size_, rows_count_ - first_row);
+      for (int row = 0; row < rows_in_tile; row++) {
+        if (tile[row] != 0) {
+          values.push_back(tile[row]);
+          rows.push_back(first_row + row);
+        }
+      }
+    }
+    cumulative[col] = static_cast<Index>(values.size());
+  }
+  return Matrix(rows_count_, cols_count_, std::move(values), std::move(rows), std::move(cumulative));
+}
+
+template <typename Value, typename Index, typename Policy>
+template <int Size>
+int BasicBlockSparseMatrix<Value, Index, Policy>::MultiplyColumn(const BasicBlockSparseMatrix& other, int col,
+                                                                 std::vector<int>& slots, std::vector<int>& pattern,
+                                                                 std::vector<Value>& tiles,
+                                                                 std::vector<Value>& values,
+                                                                 std::vector<Index>& rows) const {
+  const int size = Size != 0 ? Size : block_size_;
+  const auto tile_size = static_cast<size_t>(size) * size;
+  pattern.clear();
+  tiles.clear();
+  Index second_start = col == 0 ? 0 : other.cumulative_blocks_[col - 1];
+  for (Index second = second_start; second < other.cumulative_blocks_[col]; second++) {
+    auto inner = static_cast<int>(other.block_rows_[second]);
+    const Value* second_tile = other.values_.data() + (static_cast<size_t>(second) * tile_size);
+    Index first_start = inner == 0 ? 0 : cumulative_blocks_[inner - 1];
+    for (Index first = first_start; first < cumulative_blocks_[inner]; first++) {
+      auto row = static_cast<int>(block_rows_[first]);
+      if (slots[row] < 0) {
+        slots[row] = static_cast<int>(pattern.size());
+        pattern.push_back(row);
+        tiles.resize(tiles.size() + tile_size, 0);
+      }
+      detail::MultiplyTile<Size>(values_.data() + (static_cast<size_t>(first) * tile_size), second_tile,
+                                 tiles.data() + (static_cast<size_t>(slots[row]) * tile_size), size);
+    }
+  }
+
+  std::ranges::sort(pattern);
+  int kept = 0;
+  for (int row : pattern) {
+    const Value* tile = tiles.data() + (static_cast<size_t>(slots[row]) * tile_size);
+    slots[row] = -1;
+    if (std::none_of(tile, tile + tile_size, [](Value value) { return std::abs(value) > Matrix::kThreshold; })) {
+      continue;
+    }
+    values.insert(values.end(), tile, tile + tile_size);
+    rows.push_back(row);
+    kept++;
+  }
+  return kept;
+}
+
+template <typename Value, typename Index, typename Policy>
+template <int Size>
+BasicBlockSparseMatrix<Value, Index, Policy> BasicBlockSparseMatrix<Value, Index, Policy>::MultiplyBlocks(
+    const BasicBlockSparseMatrix& other) const {
+  // A block column costs one tile product per pair of tiles A(I, K), B(K, J).
+  std::vector<size_t> products(other.GetBlockColumnCount(), 0);
+  for (int col = 0; col < other.GetBlockColumnCount(); col++) {
+    for (Index second = col == 0 ? 0 : other.cumulative_blocks_[col - 1]; second < other.cumulative_blocks_[col];
+         second++) {
+      auto inner = static_cast<int>(other.block_rows_[second]);
+      products[col] += cumulative_blocks_[inner] - (inner == 0 ? 0 : cumulative_blocks_[inner - 1]);
+    }
+  }
+  auto bounds = PartitionColumns(products, kBlocksPerThread * Policy::Concurrency());
+  int parts_count = static_cast<int>(bounds.size()) - 1;
+
+  // As in MultiplyInner, every part appends to arrays of its own that are copied into place after the prefix sum.
+  auto tile_size = static_cast<size_t>(block_size_) * block_size_;
+  std::vector<Index> result_cumulative(other.GetBlockColumnCount(), 0);
+  std::vector<std::vector<Value>> part_values(parts_count);
+  std::vector<std::vector<Index>> part_rows(parts_count);
+  Policy::ParallelFor(parts_count, [&](int part) {
+    std::vector<int> slots(GetBlockRowCount(), -1);
+    std::vector<int> pattern;
+    std::vector<Value> tiles;
+    for (int col = bounds[part]; col < bounds[part + 1]; col++) {
+      result_cumulative[col] =
+          MultiplyColumn<Size>(other, col, slots, pattern, tiles, part_values[part], part_rows[part]);
+    }
+  });
+
+  std::partial_sum(result_cumulative.begin(), result_cumulative.end(), result_cumulative.begin());
+  Index blocks = result_cumulative.empty() ? 0 : result_cumulative.back();
+  std::vector<Value> result_values(static_cast<size_t>(blocks) * tile_size);
+  std::vector<Index> result_rows(blocks);
+  Policy::ParallelFor(parts_count, [&](int part) {
+    Index start = bounds[part] == 0 ? 0 : result_cumulative[bounds[part] - 1];
+    std::ranges::copy(part_values[part], result_values.begin() + static_cast<std::ptrdiff_t>(start * tile_size));
+    std::ranges::copy(part_rows[part], result_rows.begin() + start);
+  });
+
+  return BasicBlockSparseMatrix(rows_count_, other.cols_count_, block_size_, std::move(result_values),
+                                std::move(result_rows), std::move(result_cumulative));
+}
+
+template <typename Value, typename Index, typename Policy>
+BasicBlockSparseMatrix<Value, Index, Policy> BasicBlockSparseMatrix<Value, Index, Policy>::Multiply(
+    const BasicBlockSparseMatrix& other) const {
+  if (cols_count_ != other.rows_count_ || block_size_ != other.block_size_) {
+    throw std::invalid_argument("Block matrix dimensions do not match for multiplication");
+  }
+  switch (block_size_) {
+    case 2:
+      return MultiplyBlocks<2>(other);
+    case 3:
+      return MultiplyBlocks<3>(other);
+    case 4:
+      return MultiplyBlocks<4>(other);
+    case 6:
+      return MultiplyBlocks<6>(other);
+    default:
+      return MultiplyBlocks<0>(other);
+  }
+}
+
+}  // namespace ppc::sparse
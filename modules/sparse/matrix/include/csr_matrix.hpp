@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "sparse/matrix/include/execution.hpp"
+#include "sparse/matrix/include/sparse_matrix.hpp"
+
+namespace ppc::sparse {
+
+// Storage order of the sparse operands a task reads and writes.
+enum class SparseLayout : std::uint8_t { kCcs, kCsr };
+
+template <typename Value, typename Index, typename Policy = SequentialPolicy>
+class BasicCsrMatrix;
+
+using CsrMatrix = BasicCsrMatrix<double, int>;
+
+// Dense row-major to CSR: every row is one contiguous read, counted and then filled in blocks of rows.
+template <typename Value, typename Index = int, typename Policy = SequentialPolicy>
+BasicCsrMatrix<Value, Index, Policy> MatrixToCsr(int rows_count, int columns_count, const Value* values);
+template <typename Value, typename Index = int, typename Policy = SequentialPolicy>
+BasicCsrMatrix<Value, Index, Policy> MatrixToCsr(int rows_count, int columns_count, const std::vector<Value>& values);
+template <typename Value, typename Index, typename Policy>
+std::vector<Value> FromCsrMatrix(const BasicCsrMatrix<Value, Index, Policy>& matrix);
+
+// Compressed sparse row storage: values, column indices and cumulative row counts, the latter again holding the end
+// offset of every row. These are exactly the CCS arrays of the transpose, so the matrix wraps a BasicSparseMatrix of
+// A^T and runs the CCS kernels with the operands swapped: the row-wise Gustavson product C = A * B, which scatters
+// the rows of B selected by A(i, :) into C(i, :), is the column-wise one for C^T = B^T * A^T. Nothing is transposed
+// on the way, and row-major callers never touch a CCS array.
+template <typename Value, typename Index, typename Policy>
+class BasicCsrMatrix {
+  using Matrix = BasicSparseMatrix<Value, Index, Policy>;
+
+  Matrix transposed_;
+
+ public:
+  using value_type = Value;
+  using index_type = Index;
+  using policy_type = Policy;
+
+  constexpr static Value kThreshold = Matrix::kThreshold;
+  BasicCsrMatrix() = default;
+  // Adopts the CCS form of A^T, i.e. the CSR arrays of A, as it is.
+  explicit BasicCsrMatrix(Matrix transposed) noexcept : transposed_(std::move(transposed)) {}
+  BasicCsrMatrix(int rows, int columns, std::vector<Value> values, std::vector<Index> column_indices,
+                 std::vector<Index> cumulative_sum)
+      : transposed_(columns, rows, std::move(values), std::move(column_indices), std::move(cumulative_sum)) {}
+  // Non-owning matrix over existing CSR arrays, kept alive through storage like the CCS view.
+  BasicCsrMatrix(int rows, int columns, std::span<const Value> values, std::span<const Index> column_indices,
+                 std::span<const Index> cumulative_sum, std::shared_ptr<const void> storage = nullptr) noexcept
+      : transposed_(columns, rows, values, column_indices, cumulative_sum, std::move(storage)) {}
+  // The same matrix under another execution policy; the arrays are shared, not copied.
+  template <typename OtherPolicy>
+  explicit BasicCsrMatrix(const BasicCsrMatrix<Value, Index, OtherPolicy>& other) noexcept
+      : transposed_(other.AsTransposed()) {}
+
+  // Conversions between the layouts, one counting-sort transpose each.
+  static BasicCsrMatrix FromCcs(const Matrix& matrix) { return BasicCsrMatrix(Matrix::ComputeTranspose(matrix)); }
+  Matrix ToCcs() const { return Matrix::ComputeTranspose(transposed_); }
+  // A^T in CCS form over the arrays of this matrix, for handing the CSR data to the CCS kernels and plans.
+  const Matrix& AsTransposed() const noexcept { return transposed_; }
+
+  std::span<const Value> GetValues() const noexcept { return transposed_.GetValues(); }
+  std::span<const Index> GetColumnIndices() const noexcept { return transposed_.GetRowIndices(); }
+  std::span<const Index> GetCumulativeElements() const noexcept { return transposed_.GetCumulativeElements(); }
+  int GetRowCount() const noexcept { return transposed_.GetColumnCount(); }
+  int GetColumnCount() const noexcept { return transposed_.GetRowCount(); }
+
+  // Row-wise Gustavson product, in Accumulator precision and with the stats of BasicSparseMatrix::Multiply, which
+  // computes it as B^T * A^T and throws std::invalid_argument when the dimensions do not match. The drop policy then
+  // applies to the rows of C, which are the columns the CCS kernel sees.
+  template <typename Accumulator = Value>
+  BasicCsrMatrix Multiply(const BasicCsrMatrix& other, MultiplyStats* stats = nullptr) const {
+    return BasicCsrMatrix(other.transposed_.template Multiply<Accumulator>(transposed_, stats));
+  }
+  template <typename Accumulator = Value>
+  BasicCsrMatrix Multiply(const BasicCsrMatrix& other, const DropPolicy& drop, MultiplyStats* stats = nullptr) const {
+    return BasicCsrMatrix(other.transposed_.template Multiply<Accumulator>(transposed_, drop, stats));
+  }
+  BasicCsrMatrix operator*(const BasicCsrMatrix& other) const { return Multiply(other); }
+  // A * B on the pattern of mask, see BasicSparseMatrix::MultiplyMasked.
+  template <typename Accumulator = Value>
+  BasicCsrMatrix MultiplyMasked(const BasicCsrMatrix& other, const BasicCsrMatrix& mask,
+                                const DropPolicy& drop = {}) const {
+    return BasicCsrMatrix(other.transposed_.template MultiplyMasked<Accumulator>(transposed_, mask.transposed_, drop));
+  }
+};
+
+template <typename Value, typename Index, typename Policy>
+BasicCsrMatrix<Value, Index, Policy> MatrixToCsr(int rows_count, int columns_count, const Value* values) {
+  auto nonzero = [](Value value) { return std::abs(value) > BasicCsrMatrix<Value, Index, Policy>::kThreshold; };
+  std::vector<Index> cumulative_elements(rows_count, 0);
+  ParallelForRanges<Policy>(cumulative_elements.size(), [&](size_t first_row, size_t last_row) {
+    for (size_t row = first_row; row < last_row; row++) {
+      const Value* line = values + (row * columns_count);
+      cumulative_elements[row] = static_cast<Index>(std::count_if(line, line + columns_count, nonzero));
+    }
+  });
+
+  std::partial_sum(cumulative_elements.begin(), cumulative_elements.end(), cumulative_elements.begin());
+
+  Index nnz = cumulative_elements.empty() ? 0 : cumulative_elements.back();
+  std::vector<Value> sparse_values(nnz);
+  std::vector<Index> column_indices(nnz);
+  ParallelForRanges<Policy>(cumulative_elements.size(), [&](size_t first_row, size_t last_row) {
+    for (size_t row = first_row; row < last_row; row++) {
+      const Value* line = values + (row * columns_count);
+      Index dst = row == 0 ? 0 : cumulative_elements[row - 1];
+      for (int col = 0; col < columns_count; col++) {
+        if (!nonzero(line[col])) continue;
+        sparse_values[dst] = line[col];
+        column_indices[dst++] = col;
+      }
+    }
+  });
+  return BasicCsrMatrix<Value, Index, Policy>(rows_count, columns_count, std::move(sparse_values),
+                                              std::move(column_indices), std::move(cumulative_elements));
+}
+
+template <typename Value, typename Index, typename Policy>
+BasicCsrMatrix<Value, Index, Policy> MatrixToCsr(int rows_count, int columns_count, const std::vector<Value>& values) {
+  return MatrixToCsr<Value, Index, Policy>(rows_count, columns_count, values.data());
+}
+
+template <typename Value, typename Index, typename Policy>
+std::vector<Value> FromCsrMatrix(const BasicCsrMatrix<Value, Index, Policy>& matrix) {
+  auto columns_count = static_cast<size_t>(matrix.GetColumnCount());
+  std::vector<Value> dense_matrix(static_cast<size_t>(matrix.GetRowCount()) * columns_count, 0);
+  auto values = matrix.GetValues();
+  auto column_indices = matrix.GetColumnIndices();
+  auto cumulative = matrix.GetCumulativeElements();
+  ParallelForRanges<Policy>(cumulative.size(), [&](size_t first_row, size_t last_row) {
+    for (size_t row = first_row; row < last_row; row++) {
+      Value* line = dense_matrix.data() + (row * columns_count);
+      for (Index i = row == 0 ? 0 : cumulative[row - 1]; i < cumulative[row]; i++) line[column_indices[i]] = values[i];
+    }
+  });
+  return dense_matrix;
+}
+
+}  // namespace ppc::sparse
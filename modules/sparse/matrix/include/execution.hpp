@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace ppc::sparse {
+
+// The kernels of this library are templated on an execution policy: a stateless type with
+//   static int Concurrency();                         the number of threads ParallelFor may use;
+//   static void ParallelFor(int count, const Body&);  runs body(index) for every index in [0, count), in any order
+//                                                     and possibly concurrently, and returns once all are done,
+//                                                     rethrowing the first exception a body threw.
+// Kernels hand ParallelFor a few balanced blocks per thread rather than single columns, so a policy may schedule
+// every index as a separate job. SequentialPolicy is defined here; OmpPolicy, TbbPolicy and ThreadPoolPolicy live in
+// execution_omp.hpp, execution_tbb.hpp and execution_stl.hpp, so that only their users depend on those runtimes.
+struct SequentialPolicy {
+  static int Concurrency() noexcept { return 1; }
+
+  template <typename Body>
+  static void ParallelFor(int count, const Body& body) {
+    for (int index = 0; index < count; index++) body(index);
+  }
+};
+
+// Balanced column blocks handed out per thread; more than one lets dynamic scheduling absorb estimate errors.
+constexpr int kBlocksPerThread = 4;
+
+// Splits columns into at most parts contiguous ranges of roughly equal cost and returns the range boundaries,
+// starting at 0 and ending at column_costs.size(). A column heavier than an even share gets a range of its own.
+std::vector<int> PartitionColumns(const std::vector<size_t>& column_costs, int parts);
+
+// Runs body(first, last) over ranges that split [0, count) evenly, kBlocksPerThread of them per thread, for loops
+// whose iterations all cost about the same.
+template <typename Policy, typename Body>
+void ParallelForRanges(size_t count, const Body& body) {
+  auto threads = static_cast<size_t>(Policy::Concurrency());
+  auto ranges = static_cast<int>(std::min<size_t>(count, kBlocksPerThread * threads));
+  if (ranges <= 1) {
+    if (count != 0) body(size_t{0}, count);
+    return;
+  }
+  Policy::ParallelFor(ranges, [&](int range) { body(count * range / ranges, count * (range + 1) / ranges); });
+}
+
+}  // namespace ppc::sparse
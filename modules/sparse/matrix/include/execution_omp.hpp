@@ -0,0 +1,30 @@
+#pragma once
+
+#include <omp.h>
+
+#include <exception>
+
+namespace ppc::sparse {
+
+// Runs the indices of a ParallelFor as a dynamically scheduled OpenMP loop. Exceptions must not leave the parallel
+// region, so the first one is kept and rethrown after it.
+struct OmpPolicy {
+  static int Concurrency() noexcept { return omp_get_max_threads(); }
+
+  template <typename Body>
+  static void ParallelFor(int count, const Body& body) {
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int index = 0; index < count; index++) {
+      try {
+        body(index);
+      } catch (...) {
+#pragma omp critical
+        if (!error) error = std::current_exception();
+      }
+    }
+    if (error) std::rethrow_exception(error);
+  }
+};
+
+}  // namespace ppc::sparse
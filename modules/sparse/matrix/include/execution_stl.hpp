@@ -0,0 +1,17 @@
+#pragma once
+
+#include "core/util/include/thread_pool.hpp"
+
+namespace ppc::sparse {
+
+// Runs the indices of a ParallelFor on the process-wide ppc::util::ThreadPool.
+struct ThreadPoolPolicy {
+  static int Concurrency() { return ppc::util::ThreadPool::Shared().GetThreadsCount(); }
+
+  template <typename Body>
+  static void ParallelFor(int count, const Body& body) {
+    ppc::util::ThreadPool::Shared().ParallelFor(count, [&](int index) { body(index); });
+  }
+};
+
+}  // namespace ppc::sparse
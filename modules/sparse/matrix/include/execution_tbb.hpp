@@ -0,0 +1,17 @@
+#pragma once
+
+#include <tbb/tbb.h>
+
+namespace ppc::sparse {
+
+// Runs the indices of a ParallelFor as a tbb::parallel_for in the current task arena.
+struct TbbPolicy {
+  static int Concurrency() { return tbb::this_task_arena::max_concurrency(); }
+
+  template <typename Body>
+  static void ParallelFor(int count, const Body& body) {
+    tbb::parallel_for(0, count, [&](int index) { body(index); });
+  }
+};
+
+}  // namespace ppc::sparse
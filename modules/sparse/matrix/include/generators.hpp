@@ -0,0 +1,229 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "sparse/matrix/include/execution.hpp"
+#include "sparse/matrix/include/sparse_matrix.hpp"
+
+namespace ppc::sparse {
+
+// Seeded generators that build CCS directly. Every column draws from a stream of its own, derived from seed and the
+// column index, so one seed gives the same matrix for any policy and thread count. Values are whole numbers in
+// [1, 9], which keeps sums of products exact when kernels are compared. All of them throw std::invalid_argument on
+// negative sizes or a density outside [0, 1]. Past 2^31 entries the 64-bit Index is needed.
+
+// Every entry present with probability density.
+template <typename Value = double, typename Index = int, typename Policy = SequentialPolicy>
+BasicSparseMatrix<Value, Index, Policy> GenerateUniform(int rows_count, int columns_count, double density,
+                                                        std::uint64_t seed);
+// size x size with the entries from lower rows below to upper rows above the diagonal each present with probability
+// density.
+template <typename Value = double, typename Index = int, typename Policy = SequentialPolicy>
+BasicSparseMatrix<Value, Index, Policy> GenerateBanded(int size, int lower, int upper, double density,
+                                                       std::uint64_t seed);
+// size x size with diagonal blocks of block_size, the last one cut short, and every entry inside them present with
+// probability density.
+template <typename Value = double, typename Index = int, typename Policy = SequentialPolicy>
+BasicSparseMatrix<Value, Index, Policy> GenerateBlockDiagonal(int size, int block_size, double density,
+                                                              std::uint64_t seed);
+// Recursive-matrix (R-MAT) power-law pattern on 2^scale x 2^scale: density * 4^scale edges, each placed by picking
+// the top-left, top-right, bottom-left or bottom-right quadrant with probabilities a, b, c and 1 - a - b - c at
+// every level, with duplicates merged. The defaults are the Graph500 parameters.
+template <typename Value = double, typename Index = int, typename Policy = SequentialPolicy>
+BasicSparseMatrix<Value, Index, Policy> GenerateRMat(int scale, double density, std::uint64_t seed, double a = 0.57,
+                                                     double b = 0.19, double c = 0.19);
+
+namespace detail {
+
+// SplitMix64: a 64-bit state, cheap enough to seed once per column.
+class SplitMix64 {
+ public:
+  using result_type = std::uint64_t;
+
+  explicit SplitMix64(std::uint64_t state) : state_(state) {}
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+  result_type operator()() {
+    std::uint64_t z = (state_ += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+ private:
+  std::uint64_t state_;
+};
+
+inline SplitMix64 ColumnStream(std::uint64_t seed, int col) {
+  SplitMix64 mixer(seed ^ (0xD1B54A32D192ED03ULL * (static_cast<std::uint64_t>(col) + 1)));
+  return SplitMix64(mixer());
+}
+
+inline void CheckGeneratorArguments(int size, double density) {
+  if (size < 0) throw std::invalid_argument("Matrix dimensions must not be negative");
+  if (!(density >= 0 && density <= 1)) throw std::invalid_argument("Density must lie in [0, 1]");
+}
+
+// Appends the rows of [first_row, last_row) that pass a Bernoulli trial with probability density. The trials are
+// skipped over with geometric gaps, so the cost follows the rows kept rather than the length of the range.
+template <typename Index>
+void AppendBernoulliRows(int first_row, int last_row, double density, SplitMix64& stream, std::vector<Index>& rows) {
+  if (density <= 0) return;
+  if (density >= 1) {
+    for (int row = first_row; row < last_row; row++) rows.push_back(row);
+    return;
+  }
+  std::geometric_distribution<std::int64_t> gap(density);
+  for (std::int64_t row = first_row + gap(stream); row < last_row; row += 1 + gap(stream)) {
+    rows.push_back(static_cast<Index>(row));
+  }
+}
+
+// Builds the matrix column by column: column_rows(col, stream, rows) appends the sorted distinct rows of a column
+// and column_cost(col) estimates their number for PartitionColumns. A counting pass sizes the columns and the fill
+// pass replays the same streams, so no column is held twice and no block needs buffers of its own.
+template <typename Value, typename Index, typename Policy, typename ColumnRows, typename ColumnCost>
+BasicSparseMatrix<Value, Index, Policy> GenerateColumns(int rows_count, int columns_count, std::uint64_t seed,
+                                                        const ColumnRows& column_rows, const ColumnCost& column_cost) {
+  std::vector<size_t> costs(columns_count);
+  for (int col = 0; col < columns_count; col++) costs[col] = column_cost(col) + 1;
+  auto bounds = PartitionColumns(costs, kBlocksPerThread * Policy::Concurrency());
+  int blocks_count = static_cast<int>(bounds.size()) - 1;
+
+  std::vector<Index> cumulative(columns_count, 0);
+  Policy::ParallelFor(blocks_count, [&](int block) {
+    std::vector<Index> rows;
+    for (int col = bounds[block]; col < bounds[block + 1]; col++) {
+      rows.clear();
+      auto stream = ColumnStream(seed, col);
+      column_rows(col, stream, rows);
+      cumulative[col] = static_cast<Index>(rows.size());
+    }
+  });
+
+  std::partial_sum(cumulative.begin(), cumulative.end(), cumulative.begin());
+  Index nnz = cumulative.empty() ? 0 : cumulative.back();
+  std::vector<Value> values(nnz);
+  std::vector<Index> row_indices(nnz);
+  Policy::ParallelFor(blocks_count, [&](int block) {
+    std::vector<Index> rows;
+    std::uniform_int_distribution<int> digit(1, 9);
+    for (int col = bounds[block]; col < bounds[block + 1]; col++) {
+      rows.clear();
+      auto stream = ColumnStream(seed, col);
+      column_rows(col, stream, rows);
+      Index start = col == 0 ? 0 : cumulative[col - 1];
+      std::ranges::copy(rows, row_indices.begin() + start);
+      for (Index i = start; i < cumulative[col]; i++) values[i] = static_cast<Value>(digit(stream));
+    }
+  });
+  return BasicSparseMatrix<Value, Index, Policy>(rows_count, columns_count, std::move(values), std::move(row_indices),
+                                                 std::move(cumulative));
+}
+
+}  // namespace detail
+
+template <typename Value, typename Index, typename Policy>
+BasicSparseMatrix<Value, Index, Policy> GenerateUniform(int rows_count, int columns_count, double density,
+                                                        std::uint64_t seed) {
+  detail::CheckGeneratorArguments(std::min(rows_count, columns_count), density);
+  return detail::GenerateColumns<Value, Index, Policy>(
+      rows_count, columns_count, seed,
+      [&](int /*col*/, detail::SplitMix64& stream, std::vector<Index>& rows) {
+        detail::AppendBernoulliRows(0, rows_count, density, stream, rows);
+      },
+      [&](int /*col*/) { return static_cast<size_t>(density * rows_count); });
+}
+
+template <typename Value, typename Index, typename Policy>
+BasicSparseMatrix<Value, Index, Policy> GenerateBanded(int size, int lower, int upper, double density,
+                                                       std::uint64_t seed) {
+  detail::CheckGeneratorArguments(std::min({size, lower, upper}), density);
+  auto band = [=](int col) {
+    return std::pair{static_cast<int>(std::max<std::int64_t>(0, static_cast<std::int64_t>(col) - upper)),
+                     static_cast<int>(std::min<std::int64_t>(size, static_cast<std::int64_t>(col) + lower + 1))};
+  };
+  return detail::GenerateColumns<Value, Index, Policy>(
+      size, size, seed,
+      [&](int col, detail::SplitMix64& stream, std::vector<Index>& rows) {
+        auto [first_row, last_row] = band(col);
+        detail::AppendBernoulliRows(first_row, last_row, density, stream, rows);
+      },
+      [&](int col) {
+        auto [first_row, last_row] = band(col);
+        return static_cast<size_t>(density * (last_row - first_row));
+      });
+}
+
+template <typename Value, typename Index, typename Policy>
+BasicSparseMatrix<Value, Index, Policy> GenerateBlockDiagonal(int size, int block_size, double density,
+                                                              std::uint64_t seed) {
+  detail::CheckGeneratorArguments(size, density);
+  if (block_size <= 0) throw std::invalid_argument("Block size must be positive");
+  auto block = [=](int col) {
+    int first_row = col / block_size * block_size;
+    return std::pair{first_row, static_cast<int>(std::min<std::int64_t>(size, std::int64_t{first_row} + block_size))};
+  };
+  return detail::GenerateColumns<Value, Index, Policy>(
+      size, size, seed,
+      [&](int col, detail::SplitMix64& stream, std::vector<Index>& rows) {
+        auto [first_row, last_row] = block(col);
+        detail::AppendBernoulliRows(first_row, last_row, density, stream, rows);
+      },
+      [&](int col) {
+        auto [first_row, last_row] = block(col);
+        return static_cast<size_t>(density * (last_row - first_row));
+      });
+}
+
+template <typename Value, typename Index, typename Policy>
+BasicSparseMatrix<Value, Index, Policy> GenerateRMat(int scale, double density, std::uint64_t seed, double a,
+                                                     double b, double c) {
+  detail::CheckGeneratorArguments(scale, density);
+  if (scale > 30) throw std::invalid_argument("R-MAT scale must be at most 30");
+  double d = 1 - a - b - c;
+  if (a < 0 || b < 0 || c < 0 || d < 0) throw std::invalid_argument("R-MAT probabilities must lie in [0, 1]");
+  int size = 1 << scale;
+  auto edges = static_cast<std::int64_t>(density * static_cast<double>(size) * static_cast<double>(size));
+
+  // The quadrant choices of the levels are independent, so the column of an edge is a product of per-level bits with
+  // P(1) = b + d, and given the column every row bit is a coin with P(1) = c / (a + c) or d / (b + d). A column then
+  // draws its edge count from a binomial over all edges and its rows bit by bit, without seeing the other columns.
+  auto column_probability = [=](int col) {
+    double probability = 1;
+    for (int level = 0; level < scale; level++) probability *= ((col >> level) & 1) != 0 ? b + d : a + c;
+    return probability;
+  };
+  // Row coins compare 32-bit halves of the stream against fixed thresholds, two levels per draw.
+  auto threshold = [](double probability) { return static_cast<std::uint64_t>(probability * 4294967296.0); };
+  std::uint64_t row_given_left = threshold(a + c > 0 ? c / (a + c) : 0);
+  std::uint64_t row_given_right = threshold(b + d > 0 ? d / (b + d) : 0);
+  return detail::GenerateColumns<Value, Index, Policy>(
+      size, size, seed,
+      [&](int col, detail::SplitMix64& stream, std::vector<Index>& rows) {
+        std::binomial_distribution<std::int64_t> count(edges, column_probability(col));
+        for (std::int64_t edge = count(stream); edge > 0; edge--) {
+          int row = 0;
+          std::uint64_t coins = 0;
+          for (int level = 0; level < scale; level++) {
+            coins = (level & 1) == 0 ? stream() : coins >> 32;
+            std::uint64_t one = ((col >> level) & 1) != 0 ? row_given_right : row_given_left;
+            if ((coins & 0xFFFFFFFFULL) < one) row |= 1 << level;
+          }
+          rows.push_back(row);
+        }
+        std::ranges::sort(rows);
+        rows.erase(std::ranges::unique(rows).begin(), rows.end());
+      },
+      [&](int col) { return static_cast<size_t>(static_cast<double>(edges) * column_probability(col)); });
+}
+
+}  // namespace ppc::sparse
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "sparse/matrix/include/execution.hpp"
+#include "sparse/matrix/include/sparse_matrix.hpp"
+
+namespace ppc::sparse {
+
+constexpr size_t kMarketBlockBytes = size_t{1} << 24;
+
+// Reads a "%%MatrixMarket matrix coordinate" file (real, integer or pattern; general or symmetric) straight into
+// CCS form. The body is streamed in blocks of kMarketBlockBytes, each block split at line boundaries and parsed
+// in parallel under Policy. Entries listed more than once are summed. Throws std::runtime_error on unreadable or
+// malformed input, including a body whose entry count differs from the size line.
+template <typename Policy = SequentialPolicy>
+BasicSparseMatrix<double, int, Policy> ReadMatrixMarket(const std::string& path);
+// Writes matrix as "coordinate real general" with 1-based indices in column-major order.
+void WriteMatrixMarket(const std::string& path, const SparseMatrix& matrix);
+template <typename Policy>
+void WriteMatrixMarket(const std::string& path, const BasicSparseMatrix<double, int, Policy>& matrix) {
+  WriteMatrixMarket(path, SparseMatrix(matrix));
+}
+
+namespace detail {
+
+struct MarketEntry {
+  int row;
+  int col;
+  double value;
+};
+
+struct MarketHeader {
+  int rows_count = 0;
+  int columns_count = 0;
+  size_t entries_count = 0;
+  bool pattern = false;
+  bool symmetric = false;
+};
+
+// Reads the banner and the size line, leaving in at the first entry line.
+MarketHeader ReadMarketHeader(std::istream& in, const std::string& path);
+// Entries worth reserving for the body that in is positioned at: the declared count, capped by the shape and by the
+// bytes left, so that a bogus size line cannot ask for an allocation the file could never fill.
+size_t ReservedEntries(std::istream& in, const MarketHeader& header);
+// Parses the entry lines in [begin, end); the range always starts and ends on a line boundary. Every entry is kept,
+// zeros included, and mirrored ones added. Returns the number of entry lines.
+size_t ParseMarketLines(const char* begin, const char* end, const MarketHeader& header, std::vector<MarketEntry>& out);
+
+// Splits a block of whole lines into one piece per thread at newline boundaries and parses them concurrently.
+// Returns the number of entry lines.
+template <typename Policy>
+size_t ParseMarketBlock(const std::string& block, const MarketHeader& header, std::vector<MarketEntry>& entries) {
+  int parts_count = std::max(1, Policy::Concurrency());
+  std::vector<const char*> bounds(parts_count + 1);
+  bounds[0] = block.data();
+  bounds[parts_count] = block.data() + block.size();
+  for (int part = 1; part < parts_count; part++) {
+    const char* guess = block.data() + (block.size() * part / parts_count);
+    guess = std::max(guess, bounds[part - 1]);
+    const char* line_end = static_cast<const char*>(std::memchr(guess, '\n', bounds[parts_count] - guess));
+    bounds[part] = line_end == nullptr ? bounds[parts_count] : line_end + 1;
+  }
+
+  std::vector<std::vector<MarketEntry>> parsed(parts_count);
+  std::vector<size_t> lines(parts_count, 0);
+  Policy::ParallelFor(parts_count, [&](int part) {
+    lines[part] = ParseMarketLines(bounds[part], bounds[part + 1], header, parsed[part]);
+  });
+  for (const auto& part : parsed) entries.insert(entries.end(), part.begin(), part.end());
+  return std::reduce(lines.begin(), lines.end(), size_t{0});
+}
+
+// Coordinate files may list an entry more than once, meaning the sum. The columns of sorted are in row order, so
+// repeats are adjacent: every column is folded within its slice, sums that cancel to within kThreshold left out,
+// and the slices then compacted.
+template <typename Policy>
+BasicSparseMatrix<double, int, Policy> SumDuplicateEntries(const BasicSparseMatrix<double, int, Policy>& sorted) {
+  auto cumulative = sorted.GetCumulativeElements();
+  std::vector<double> values(sorted.GetValues().begin(), sorted.GetValues().end());
+  std::vector<int> rows(sorted.GetRowIndices().begin(), sorted.GetRowIndices().end());
+  std::vector<int> kept(cumulative.size(), 0);
+  ParallelForRanges<Policy>(cumulative.size(), [&](size_t first_col, size_t last_col) {
+    for (size_t col = first_col; col < last_col; col++) {
+      int start = col == 0 ? 0 : cumulative[col - 1];
+      int write = start;
+      for (int i = start; i < cumulative[col]; i++) {
+        if (write > start && rows[write - 1] == rows[i]) {
+          values[write - 1] += values[i];
+        } else {
+          values[write] = values[i];
+          rows[write++] = rows[i];
+        }
+      }
+      auto cancelled = [&](int i) { return std::abs(values[i]) <= SparseMatrix::kThreshold; };
+      int folded = write;
+      write = start;
+      for (int i = start; i < folded; i++) {
+        if (cancelled(i)) continue;
+        values[write] = values[i];
+        rows[write++] = rows[i];
+      }
+      kept[col] = write - start;
+    }
+  });
+  if (std::reduce(kept.begin(), kept.end(), size_t{0}) == values.size()) return sorted;
+
+  std::vector<int> compacted(cumulative.size(), 0);
+  int write = 0;
+  for (size_t col = 0; col < cumulative.size(); col++) {
+    int start = col == 0 ? 0 : cumulative[col - 1];
+    std::copy_n(values.begin() + start, kept[col], values.begin() + write);
+    std::copy_n(rows.begin() + start, kept[col], rows.begin() + write);
+    write += kept[col];
+    compacted[col] = write;
+  }
+  values.resize(write);
+  rows.resize(write);
+  return BasicSparseMatrix<double, int, Policy>(sorted.GetRowCount(), sorted.GetColumnCount(), std::move(values),
+                                                std::move(rows), std::move(compacted));
+}
+
+}  // namespace detail
+
+template <typename Policy>
+BasicSparseMatrix<double, int, Policy> ReadMatrixMarket(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open()) throw std::runtime_error("Cannot open Matrix Market file: " + path);
+  detail::MarketHeader header = detail::ReadMarketHeader(in, path);
+
+  std::vector<detail::MarketEntry> entries;
+  entries.reserve(detail::ReservedEntries(in, header));
+  size_t lines = 0;
+  std::string block;
+  std::string carry;
+  std::vector<char> buffer(kMarketBlockBytes);
+  while (in) {
+    in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    auto read = static_cast<size_t>(in.gcount());
+    if (read == 0) break;
+    block.assign(carry);
+    block.append(buffer.data(), read);
+    size_t last_newline = block.rfind('\n');
+    if (last_newline == std::string::npos) {
+      carry.swap(block);
+      continue;
+    }
+    carry.assign(block, last_newline + 1);
+    block.resize(last_newline + 1);
+    lines += detail::ParseMarketBlock<Policy>(block, header, entries);
+  }
+  if (!carry.empty()) lines += detail::ParseMarketBlock<Policy>(carry, header, entries);
+  if (lines != header.entries_count) {
+    throw std::runtime_error("Matrix Market file " + path + " declares " + std::to_string(header.entries_count) +
+                             " entries but holds " + std::to_string(lines));
+  }
+
+  // Counting sort by row builds the transpose; transposing it back leaves every column sorted by row.
+  std::vector<int> row_cumulative(header.rows_count, 0);
+  for (const auto& entry : entries) row_cumulative[entry.row]++;
+  std::partial_sum(row_cumulative.begin(), row_cumulative.end(), row_cumulative.begin());
+  std::vector<int> next(header.rows_count, 0);
+  for (int row = 1; row < header.rows_count; row++) next[row] = row_cumulative[row - 1];
+
+  std::vector<double> values(entries.size());
+  std::vector<int> columns(entries.size());
+  for (const auto& entry : entries) {
+    int dst = next[entry.row]++;
+    values[dst] = entry.value;
+    columns[dst] = entry.col;
+  }
+  using Matrix = BasicSparseMatrix<double, int, Policy>;
+  Matrix by_rows(header.columns_count, header.rows_count, std::move(values), std::move(columns),
+                 std::move(row_cumulative));
+  return detail::SumDuplicateEntries(Matrix::ComputeTranspose(by_rows));
+}
+
+}  // namespace ppc::sparse
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "sparse/matrix/include/execution.hpp"
+#include "sparse/matrix/include/sparse_matrix.hpp"
+
+namespace ppc::sparse {
+
+template <typename Value, typename Index, typename Policy = SequentialPolicy>
+class BasicChainPlan;
+
+using ChainPlan = BasicChainPlan<double, int>;
+
+// One product of a chain. The operands are numbered 0 to n - 1 and the product of step s is operand n + s, so the
+// last step yields the whole chain.
+struct ChainStep {
+  int first = 0;
+  int second = 0;
+};
+
+// What the ordering knows about an operand or a sub-product: its shape, its expected nnz and the cost of forming it,
+// counted as the products summed plus the entries written on the way.
+struct ChainEstimate {
+  int rows = 0;
+  int cols = 0;
+  double nnz = 0;
+  double cost = 0;
+};
+
+namespace detail {
+
+// X * Y after flops products. With the products landing uniformly on the rows x cols positions of the result, a
+// position stays empty with probability exp(-flops / positions), which gives the expected nnz.
+inline ChainEstimate EstimateChainProduct(const ChainEstimate& first, const ChainEstimate& second, double flops) {
+  double positions = static_cast<double>(first.rows) * second.cols;
+  double nnz = positions == 0 ? 0 : -positions * std::expm1(-flops / positions);
+  return {first.rows, second.cols, nnz, first.cost + second.cost + flops + nnz};
+}
+
+}  // namespace detail
+
+// Association order and cached structure of operands[0] * ... * operands[n - 1]. The constructor picks the order
+// of least estimated cost by the matrix-chain dynamic program: products of two operands are counted exactly, longer
+// sub-chains estimated from the nnz of their factors, so R^T * A * P costs one symbolic pass over its operands to
+// order. Multiply keeps a BasicSpGEMMPlan per step and the intermediates in CCS form in buffers owned by the plan,
+// so repeated chains with the same patterns replay the numeric phases into memory that is already allocated.
+template <typename Value, typename Index, typename Policy>
+class BasicChainPlan {
+  using Matrix = BasicSparseMatrix<Value, Index, Policy>;
+
+  std::vector<std::pair<int, int>> shapes_;
+  std::vector<ChainStep> steps_;
+  double cost_ = 0;
+  std::vector<BasicSpGEMMPlan<Value, Index, Policy>> plans_;
+  // The product of every step but the last, which Multiply hands out in arrays of its own.
+  std::vector<SparseArrays<Value, Index>> buffers_;
+
+ public:
+  BasicChainPlan() = default;
+  // Throws std::invalid_argument for fewer than two operands or dimensions that do not chain.
+  explicit BasicChainPlan(std::span<const Matrix> operands);
+
+  const std::vector<ChainStep>& GetSteps() const noexcept { return steps_; }
+  // Estimated products summed plus intermediate entries written, in the order chosen.
+  double GetEstimatedCost() const noexcept { return cost_; }
+  // True when operands have the count and shapes the order was chosen for.
+  bool Fits(std::span<const Matrix> operands) const noexcept;
+  // The chain, every step pruned by drop. stats, if given, receives the work of all steps, with output_nnz that of
+  // the result. Throws std::invalid_argument unless Fits(operands).
+  Matrix Multiply(std::span<const Matrix> operands, MultiplyStats* stats = nullptr, const DropPolicy& drop = {});
+};
+
+template <typename Value, typename Index, typename Policy>
+BasicChainPlan<Value, Index, Policy>::BasicChainPlan(std::span<const Matrix> operands) {
+  if (operands.size() < 2) throw std::invalid_argument("A chain product needs at least two operands");
+  int count = static_cast<int>(operands.size());
+  for (int i = 0; i < count; i++) {
+    if (i > 0 && operands[i - 1].GetColumnCount() != operands[i].GetRowCount()) {
+      throw std::invalid_argument("Matrix dimensions do not match for multiplication");
+    }
+    shapes_.emplace_back(operands[i].GetRowCount(), operands[i].GetColumnCount());
+  }
+
+  // best[i][j] is the cheapest way found to form operands i to j, and split[i][j] the last product it takes.
+  std::vector<std::vector<ChainEstimate>> best(count, std::vector<ChainEstimate>(count));
+  std::vector<std::vector<int>> split(count, std::vector<int>(count, 0));
+  for (int i = 0; i < count; i++) {
+    best[i][i] = {operands[i].GetRowCount(), operands[i].GetColumnCount(),
+                  static_cast<double>(operands[i].GetValues().size()), 0};
+  }
+  for (int length = 2; length <= count; length++) {
+    for (int i = 0; i + length <= count; i++) {
+      int j = i + length - 1;
+      best[i][j].cost = std::numeric_limits<double>::infinity();
+      for (int s = i; s < j; s++) {
+        double flops = 0;
+        if (length == 2) {
+          auto columns = detail::EstimateColumnFlops(operands[i], operands[j]);
+          flops = static_cast<double>(std::reduce(columns.begin(), columns.end(), size_t{0}));
+        } else if (operands[s].GetColumnCount() > 0) {
+          // Every entry of the right factor meets the entries of one column of the left one, nnz / inner of them.
+          flops = best[i][s].nnz * best[s + 1][j].nnz / operands[s].GetColumnCount();
+        }
+        auto candidate = detail::EstimateChainProduct(best[i][s], best[s + 1][j], flops);
+        if (candidate.cost < best[i][j].cost) {
+          best[i][j] = candidate;
+          split[i][j] = s;
+        }
+      }
+    }
+  }
+  cost_ = best[0][count - 1].cost;
+
+  std::function<int(int, int)> emit = [&](int first, int last) {
+    if (first == last) return first;
+    int left = emit(first, split[first][last]);
+    int right = emit(split[first][last] + 1, last);
+    steps_.push_back({left, right});
+    return count + static_cast<int>(steps_.size()) - 1;
+  };
+  emit(0, count - 1);
+  plans_.resize(steps_.size());
+  buffers_.resize(steps_.size() - 1);
+}
+
+template <typename Value, typename Index, typename Policy>
+bool BasicChainPlan<Value, Index, Policy>::Fits(std::span<const Matrix> operands) const noexcept {
+  if (operands.size() != shapes_.size()) return false;
+  for (size_t i = 0; i < operands.size(); i++) {
+    if (shapes_[i] != std::pair(operands[i].GetRowCount(), operands[i].GetColumnCount())) return false;
+  }
+  return !shapes_.empty();
+}
+
+template <typename Value, typename Index, typename Policy>
+BasicSparseMatrix<Value, Index, Policy> BasicChainPlan<Value, Index, Policy>::Multiply(std::span<const Matrix> operands,
+                                                                                       MultiplyStats* stats,
+                                                                                       const DropPolicy& drop) {
+  if (!Fits(operands)) throw std::invalid_argument("Operands do not match the chain plan");
+  std::vector<Matrix> products(steps_.size());
+  auto operand = [&](int id) -> const Matrix& {
+    auto index = static_cast<size_t>(id);
+    return index < operands.size() ? operands[index] : products[index - operands.size()];
+  };
+
+  MultiplyStats totals;
+  for (size_t s = 0; s < steps_.size(); s++) {
+    const Matrix& first = operand(steps_[s].first);
+    const Matrix& second = operand(steps_[s].second);
+    if (!plans_[s].Matches(first, second)) plans_[s] = BasicSpGEMMPlan<Value, Index, Policy>(first, second);
+    MultiplyStats local;
+    if (s + 1 == steps_.size()) {
+      products[s] = plans_[s].Multiply(first, second, &local, drop);
+    } else {
+      products[s] = plans_[s].Multiply(first, second, buffers_[s], &local, drop);
+    }
+    totals += local;
+  }
+  totals.output_nnz = products.back().GetValues().size();
+  if (stats != nullptr) *stats = totals;
+  return std::move(products.back());
+}
+
+}  // namespace ppc::sparse
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <span>
+
+namespace ppc::sparse {
+
+// Dot product of two sparse vectors held as strictly increasing index lists with matching values: the sum of
+// first_values[p] * second_values[q] over all first_indices[p] == second_indices[q], accumulated in Accumulator.
+// With 32-bit indices the intersection runs block-wise on AVX-512 or AVX2 when the CPU has them, found once at
+// first call; 64-bit indices and other CPUs take the scalar merge.
+template <typename Accumulator, typename Value, typename Index>
+Accumulator SparseDot(std::span<const Index> first_indices, std::span<const Value> first_values,
+                      std::span<const Index> second_indices, std::span<const Value> second_values);
+
+// Kernel SparseDot picks for 32-bit indices: "avx512", "avx2" or "scalar".
+const char* SparseDotKernel();
+
+}  // namespace ppc::sparse
@@ -0,0 +1,1289 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "sparse/matrix/include/execution.hpp"
+#include "sparse/matrix/include/sparse_dot.hpp"
+
+namespace ppc::sparse {
+
+// Output columns with fewer products than rows / kHashAccumulatorRatio accumulate in a hash table sized to the column
+// rather than in dense per-block arrays of rows entries, which are only allocated once a denser column shows up.
+constexpr int kHashAccumulatorRatio = 16;
+
+// Entries are whole numbers in [0, 250], about half of them zero.
+template <typename Value = double>
+std::vector<Value> GenerateRandomMatrix(int dimension);
+// Dense reference product of row-major matrices on ppc::util::MultiplyDense and the shared thread pool.
+std::vector<double> MultiplyMatrices(const std::vector<double>& first_matrix, int first_rows, int first_columns,
+                                     const std::vector<double>& second_matrix, int second_rows, int second_columns);
+
+template <typename Value, typename Index, typename Policy = SequentialPolicy>
+class BasicSparseMatrix;
+template <typename Value, typename Index, typename Policy = SequentialPolicy>
+class BasicSpGEMMPlan;
+template <typename Entry>
+class HashAccumulator;
+
+// Value is float or double and Index int or std::int64_t; 32-bit indices halve index traffic, 64-bit ones keep
+// offsets valid past 2^31 entries. Policy picks how the kernels of the matrix run in parallel, see execution.hpp.
+using SparseMatrix = BasicSparseMatrix<double, int>;
+using SpGEMMPlan = BasicSpGEMMPlan<double, int>;
+
+// Dense row-major to CCS, swept in column tiles: a per-tile count, a prefix sum over columns, then a per-tile fill.
+template <typename Value, typename Index = int, typename Policy = SequentialPolicy>
+BasicSparseMatrix<Value, Index, Policy> MatrixToSparse(int rows_count, int columns_count, const Value* values);
+template <typename Value, typename Index = int, typename Policy = SequentialPolicy>
+BasicSparseMatrix<Value, Index, Policy> MatrixToSparse(int rows_count, int columns_count,
+                                                       const std::vector<Value>& values);
+template <typename Value, typename Index, typename Policy>
+std::vector<Value> FromSparseMatrix(const BasicSparseMatrix<Value, Index, Policy>& matrix);
+
+// Work done by one multiply. flops counts the products A(i, k) * B(k, j); accumulator_hits counts the products
+// that landed on a row already touched in the same output column, so flops - accumulator_hits is C's structural nnz
+// and output_nnz what is left of it after the DropPolicy.
+struct MultiplyStats {
+  size_t output_nnz = 0;
+  size_t flops = 0;
+  size_t accumulator_hits = 0;
+
+  MultiplyStats& operator+=(const MultiplyStats& other) {
+    output_nnz += other.output_nnz;
+    flops += other.flops;
+    accumulator_hits += other.accumulator_hits;
+    return *this;
+  }
+};
+
+// Which computed entries of a product are stored, decided column by column in the numeric phase. An entry is kept
+// when its magnitude is above absolute and at least relative times the largest magnitude in its column, and then
+// only the top_k largest of a column survive, ties going to the smaller row; top_k = 0 keeps them all. Pruning
+// bounds the fill-in of repeated products, e.g. the Galerkin products of an algebraic multigrid setup. The default
+// keeps every entry that does not cancel to within kThreshold, whatever its sign.
+struct DropPolicy {
+  double absolute = 1e-6;
+  double relative = 0;
+  int top_k = 0;
+
+  template <typename Entry>
+  bool Keeps(Entry value) const {
+    return std::abs(value) > static_cast<Entry>(absolute);
+  }
+};
+
+// CCS arrays held by value: the storage of a matrix built from vectors, or buffers a plan writes products into and
+// that keep their capacity from one product to the next.
+template <typename Value, typename Index>
+struct SparseArrays {
+  std::vector<Value> values;
+  std::vector<Index> row_indices;
+  std::vector<Index> cumulative_elements;
+};
+
+template <typename Value, typename Index, typename Policy>
+class BasicSparseMatrix {
+  template <typename, typename, typename>
+  friend class BasicSparseMatrix;
+  friend class BasicSpGEMMPlan<Value, Index, Policy>;
+
+  int rows_count_ = 0;
+  int cols_count_ = 0;
+  // Keeps the memory behind the spans alive: the matrix's own arrays, a file mapping, or nothing when the caller
+  // owns the memory and outlives the matrix.
+  std::shared_ptr<const void> storage_;
+  std::span<const Value> values_;
+  std::span<const Index> row_indices_;
+  std::span<const Index> cumulative_elements_;
+
+  static Index CountElements(int index, std::span<const Index> elements_count);
+
+  // Gustavson column kernel: scatters A * B(:, col) into a dense accumulator,
+  // leaves the sorted list of touched rows in pattern and returns the number of products.
+  template <typename Accumulator>
+  size_t AccumulateColumn(const BasicSparseMatrix& other, int col, std::vector<Accumulator>& accumulator,
+                          std::vector<int>& marker, std::vector<int>& pattern) const;
+  bool PrefersHashAccumulator(size_t products) const noexcept {
+    return products * kHashAccumulatorRatio < static_cast<size_t>(rows_count_);
+  }
+  // Symbolic phase: structural nnz of C(:, col), without touching any values.
+  int CountColumnNonZeros(const BasicSparseMatrix& other, int col, std::vector<int>& marker) const;
+  template <typename Entry>
+  int CountColumnNonZeros(const BasicSparseMatrix& other, int col, size_t products,
+                          HashAccumulator<Entry>& table) const;
+  // Numeric phase: writes C(:, col) into the preallocated slice, adds its work to stats and returns the number of
+  // kept entries.
+  template <typename Accumulator>
+  int ComputeColumn(const BasicSparseMatrix& other, int col, std::vector<Accumulator>& accumulator,
+                    std::vector<int>& marker, std::vector<int>& pattern, Value* values, Index* rows,
+                    MultiplyStats& stats, const DropPolicy& drop) const;
+  template <typename Accumulator>
+  int ComputeColumn(const BasicSparseMatrix& other, int col, size_t products, HashAccumulator<Accumulator>& table,
+                    Value* values, Index* rows, MultiplyStats& stats, const DropPolicy& drop) const;
+  // Squeezes out the slice tails left by dropped entries.
+  template <typename Element>
+  static void CompactColumns(std::vector<Element>& values, std::vector<Index>& rows, std::vector<Index>& cumulative,
+                             const std::vector<int>& kept);
+  // Inner-product column kernel: appends C(i, col) = SparseDot(A(i, :), B(:, col)) for every row i of A whose dot
+  // the drop policy keeps, reading the rows of A as the columns of transposed. Returns the number appended.
+  template <typename Accumulator>
+  static int DotColumn(const BasicSparseMatrix& transposed, const BasicSparseMatrix& other, int col,
+                       std::vector<Value>& values, std::vector<Index>& rows, const DropPolicy& drop);
+  // Masked column kernel: writes the entries of C(:, col) on the pattern of mask(:, col) that the drop policy keeps
+  // into the preallocated slice and returns their number. It runs whichever is cheaper for the column: one SparseDot
+  // per mask entry, or a Gustavson pass that accumulates only into the mask's rows.
+  template <typename Accumulator>
+  int MaskedColumn(const BasicSparseMatrix& transposed, const BasicSparseMatrix& other, const BasicSparseMatrix& mask,
+                   int col, std::vector<Accumulator>& accumulator, std::vector<int>& marker, Value* values,
+                   Index* rows, const DropPolicy& drop) const;
+  // Merges A(:, col) and B(:, col) into the preallocated slice, leaving out sums that cancel to within kThreshold,
+  // and returns the number written.
+  int AddColumn(const BasicSparseMatrix& other, int col, Value* values, Index* rows) const;
+
+ public:
+  using value_type = Value;
+  using index_type = Index;
+  using policy_type = Policy;
+
+  constexpr static Value kThreshold = static_cast<Value>(1e-6);
+  BasicSparseMatrix() = default;
+  BasicSparseMatrix(int rows, int columns, std::vector<Value> values, std::vector<Index> rows_index,
+                    std::vector<Index> cumulative_sum);
+  // Non-owning matrix over existing CCS arrays; storage, if given, is kept alive as long as any copy of the matrix.
+  BasicSparseMatrix(int rows, int columns, std::span<const Value> values, std::span<const Index> rows_index,
+                    std::span<const Index> cumulative_sum, std::shared_ptr<const void> storage = nullptr) noexcept
+      : rows_count_(rows),
+        cols_count_(columns),
+        storage_(std::move(storage)),
+        values_(values),
+        row_indices_(rows_index),
+        cumulative_elements_(cumulative_sum) {}
+  // The same matrix under another execution policy; the arrays are shared, not copied.
+  template <typename OtherPolicy>
+  explicit BasicSparseMatrix(const BasicSparseMatrix<Value, Index, OtherPolicy>& other) noexcept
+      : BasicSparseMatrix(other.rows_count_, other.cols_count_, other.values_, other.row_indices_,
+                          other.cumulative_elements_, other.storage_) {}
+
+  std::span<const Value> GetValues() const noexcept { return values_; }
+  std::span<const Index> GetRowIndices() const noexcept { return row_indices_; }
+  std::span<const Index> GetCumulativeElements() const noexcept { return cumulative_elements_; }
+  int GetColumnCount() const noexcept { return cols_count_; }
+  int GetRowCount() const noexcept { return rows_count_; }
+
+  // Sums products in Accumulator precision. Multiply<double>() on float matrices keeps float storage and traffic but
+  // rounds like the double kernel. stats, if given, receives the work of this call. Every product kernel stores only
+  // what drop keeps. Throws std::invalid_argument unless other has as many rows as this matrix has columns.
+  template <typename Accumulator = Value>
+  BasicSparseMatrix Multiply(const BasicSparseMatrix& other, MultiplyStats* stats = nullptr) const;
+  template <typename Accumulator = Value>
+  BasicSparseMatrix Multiply(const BasicSparseMatrix& other, const DropPolicy& drop,
+                             MultiplyStats* stats = nullptr) const;
+  BasicSparseMatrix operator*(const BasicSparseMatrix& other) const noexcept(false);
+  // Inner-product multiply over a transposed copy of A: every C(i, j) is one sorted-list intersection of A(i, :)
+  // and B(:, j) in SparseDot. It suits products whose output is small next to the inner dimension, where Gustavson
+  // would scatter long columns of A for few results.
+  template <typename Accumulator = Value>
+  BasicSparseMatrix MultiplyInner(const BasicSparseMatrix& other, const DropPolicy& drop = {}) const;
+  // A * B restricted to the pattern of mask: entries off the pattern are never computed and the mask's values are
+  // never read. Throws std::invalid_argument unless mask is rows x other's columns.
+  template <typename Accumulator = Value>
+  BasicSparseMatrix MultiplyMasked(const BasicSparseMatrix& other, const BasicSparseMatrix& mask,
+                                   const DropPolicy& drop = {}) const;
+  // A^T * B, e.g. the A^T * A of normal equations, as ComputeTranspose followed by the Gustavson Multiply: one
+  // counting-sort pass over A, after which each B(:, j) only visits the columns of A that share a row with it.
+  // Throws std::invalid_argument unless A and B have the same number of rows.
+  template <typename Accumulator = Value>
+  BasicSparseMatrix MultiplyTransposed(const BasicSparseMatrix& other, const DropPolicy& drop = {}) const;
+
+  // A + B, leaving out entries that cancel to within kThreshold. Throws std::invalid_argument unless the shapes
+  // match. Matrices are immutable views, so += rebinds this one to the sum and other copies keep the old arrays.
+  BasicSparseMatrix operator+(const BasicSparseMatrix& other) const;
+  BasicSparseMatrix& operator+=(const BasicSparseMatrix& other);
+  // Every value times factor. The result shares the row indices and cumulative counts of this matrix rather than
+  // copying them; a zero factor gives an empty matrix.
+  BasicSparseMatrix operator*(Value factor) const;
+  BasicSparseMatrix& operator*=(Value factor);
+  friend BasicSparseMatrix operator*(Value factor, const BasicSparseMatrix& matrix) { return matrix * factor; }
+
+  // Counting-sort transpose: one histogram pass over the row indices, a prefix sum, then a stable scatter.
+  static BasicSparseMatrix ComputeTranspose(const BasicSparseMatrix& matrix);
+};
+
+// Output structure of first * second for a fixed pair of sparsity patterns. The constructor runs the symbolic
+// phase once; Multiply replays only the numeric phase through the cached scatter map, so repeated products with
+// changing values skip the accumulator, the marker sweep and the per-column sort.
+template <typename Value, typename Index, typename Policy>
+class BasicSpGEMMPlan {
+  using Matrix = BasicSparseMatrix<Value, Index, Policy>;
+
+  int rows_count_ = 0;
+  int cols_count_ = 0;
+  std::vector<Index> row_indices_;
+  std::vector<Index> cumulative_elements_;
+  // Output position of every product A(i, k) * B(k, j), in the order the numeric phase visits them. The product
+  // count can pass the output nnz by far, so its offsets are size_t whatever Index is.
+  std::vector<Index> scatter_;
+  std::vector<size_t> scatter_cumulative_;
+  std::vector<Index> first_rows_;
+  std::vector<Index> first_cumulative_;
+  std::vector<Index> second_rows_;
+  std::vector<Index> second_cumulative_;
+  // Column blocks of roughly equal product count, reused by every Multiply.
+  std::vector<int> column_bounds_{0};
+
+  void BuildColumn(const Matrix& first, const Matrix& second, int col, std::vector<int>& marker,
+                   std::vector<Index>& position, std::vector<int>& pattern);
+  void BuildColumn(const Matrix& first, const Matrix& second, int col, HashAccumulator<Index>& table);
+  template <typename Accumulator>
+  int ComputeColumn(const Matrix& first, const Matrix& second, int col, std::vector<Accumulator>& values,
+                    std::vector<Index>& rows, MultiplyStats& stats, const DropPolicy& drop) const;
+  // Numeric phase into the given arrays, whatever they held before.
+  template <typename Accumulator>
+  MultiplyStats Compute(const Matrix& first, const Matrix& second, std::vector<Accumulator>& values,
+                        std::vector<Index>& rows, std::vector<Index>& cumulative, const DropPolicy& drop) const;
+
+ public:
+  BasicSpGEMMPlan() = default;
+  // Throws std::invalid_argument unless second has as many rows as first has columns.
+  BasicSpGEMMPlan(const Matrix& first, const Matrix& second);
+
+  bool Matches(const Matrix& first, const Matrix& second) const noexcept;
+  // The pattern is the structural one, so a drop policy prunes each product afresh.
+  template <typename Accumulator = Value>
+  Matrix Multiply(const Matrix& first, const Matrix& second, MultiplyStats* stats = nullptr,
+                  const DropPolicy& drop = {}) const;
+  // The same product written into buffers, which are reused rather than reallocated when their capacity suffices.
+  // The result views the buffers and is valid until they are written again.
+  Matrix Multiply(const Matrix& first, const Matrix& second, SparseArrays<Value, Index>& buffers,
+                  MultiplyStats* stats = nullptr, const DropPolicy& drop = {}) const;
+};
+
+// Open-addressing map from output row to a partial sum, filled one column at a time. Each column resizes the probed
+// part to at least twice its product count, so the footprint follows the column instead of the row count, and
+// Clear only resets the slots the column used.
+template <typename Entry>
+class HashAccumulator {
+  std::vector<int> keys_;
+  std::vector<Entry> entries_;
+  std::vector<size_t> used_;
+  size_t mask_ = 0;
+  int shift_ = 60;
+
+ public:
+  void Reset(size_t products) {
+    size_t capacity = 16;
+    shift_ = 60;
+    while (capacity < 2 * products) {
+      capacity *= 2;
+      shift_--;
+    }
+    if (keys_.size() < capacity) {
+      keys_.assign(capacity, -1);
+      entries_.resize(capacity);
+    }
+    mask_ = capacity - 1;
+  }
+
+  // Entry of row, inserted as zero on first touch.
+  Entry& operator[](int row) {
+    // Fibonacci hashing: the top bits of the product mix all bits of row, so strided rows spread out.
+    auto slot = static_cast<size_t>((static_cast<std::uint64_t>(row) * 0x9E3779B97F4A7C15ULL) >> shift_);
+    while (keys_[slot] != row) {
+      if (keys_[slot] == -1) {
+        keys_[slot] = row;
+        entries_[slot] = 0;
+        used_.push_back(slot);
+        break;
+      }
+      slot = (slot + 1) & mask_;
+    }
+    return entries_[slot];
+  }
+
+  [[nodiscard]] size_t Size() const { return used_.size(); }
+
+  // Visits (row, entry) in increasing row order.
+  template <typename Visit>
+  void ForEachSorted(Visit visit) {
+    std::sort(used_.begin(), used_.end(), [&](size_t a, size_t b) { return keys_[a] < keys_[b]; });
+    for (size_t slot : used_) visit(keys_[slot], entries_[slot]);
+  }
+
+  void Clear() {
+    for (size_t slot : used_) keys_[slot] = -1;
+    used_.clear();
+  }
+};
+
+namespace detail {
+
+// Values of a scaled matrix, which views them next to the pattern arrays of its source and keeps those alive too.
+template <typename Value>
+struct ScaledArrays {
+  std::vector<Value> values;
+  std::shared_ptr<const void> pattern;
+};
+
+// Width of the column tile swept row by row: each row contributes one contiguous run of kTileColumns doubles
+// instead of a stride-columns_count access per element.
+constexpr int kTileColumns = 64;
+
+template <typename Value, typename Index>
+void CountTile(const Value* values, int rows_count, int columns_count, int first_col, int last_col,
+               std::vector<Index>& counts) {
+  for (int row = 0; row < rows_count; row++) {
+    const Value* line = values + (static_cast<size_t>(row) * columns_count);
+    for (int col = first_col; col < last_col; col++) {
+      if (std::abs(line[col]) > BasicSparseMatrix<Value, Index>::kThreshold) counts[col]++;
+    }
+  }
+}
+
+template <typename Value, typename Index>
+void FillTile(const Value* values, int rows_count, int columns_count, int first_col, int last_col,
+              const std::vector<Index>& cumulative, std::vector<Value>& sparse_values,
+              std::vector<Index>& row_indices) {
+  std::vector<Index> next(last_col - first_col);
+  for (int col = first_col; col < last_col; col++) next[col - first_col] = col == 0 ? 0 : cumulative[col - 1];
+  for (int row = 0; row < rows_count; row++) {
+    const Value* line = values + (static_cast<size_t>(row) * columns_count);
+    for (int col = first_col; col < last_col; col++) {
+      Value val = line[col];
+      if (std::abs(val) > BasicSparseMatrix<Value, Index>::kThreshold) {
+        Index dst = next[col - first_col]++;
+        sparse_values[dst] = val;
+        row_indices[dst] = row;
+      }
+    }
+  }
+}
+
+// Work estimate of every column of first * second: the products A(i, k) * B(k, col), i.e. the lengths of the
+// columns of A selected by B(:, col).
+template <typename Value, typename Index, typename Policy>
+std::vector<size_t> EstimateColumnFlops(const BasicSparseMatrix<Value, Index, Policy>& first,
+                                        const BasicSparseMatrix<Value, Index, Policy>& second) {
+  auto first_sums = first.GetCumulativeElements();
+  auto second_rows = second.GetRowIndices();
+  auto second_sums = second.GetCumulativeElements();
+  std::vector<size_t> flops(second.GetColumnCount(), 0);
+  ParallelForRanges<Policy>(flops.size(), [&](size_t first_col, size_t last_col) {
+    for (size_t col = first_col; col < last_col; col++) {
+      Index start = col == 0 ? 0 : second_sums[col - 1];
+      for (Index j = start; j < second_sums[col]; j++) {
+        Index inner = second_rows[j];
+        flops[col] += first_sums[inner] - (inner == 0 ? 0 : first_sums[inner - 1]);
+      }
+    }
+  });
+  return flops;
+}
+
+// Cost of every column for PartitionColumns when it is proportional to the column's length.
+template <typename Index>
+std::vector<size_t> ColumnLengths(std::span<const Index> cumulative) {
+  std::vector<size_t> lengths(cumulative.size());
+  std::adjacent_difference(cumulative.begin(), cumulative.end(), lengths.begin());
+  return lengths;
+}
+
+// Applies the relative and top_k parts of drop to the count entries of one output column, which the kernels left in
+// row order in values and rows after checking the absolute part, and returns how many remain at the front.
+template <typename Entry, typename Index>
+int PruneColumn(Entry* values, Index* rows, int count, const DropPolicy& drop) {
+  int kept = count;
+  auto keep_if = [&](auto keep) {
+    int write = 0;
+    for (int i = 0; i < kept; i++) {
+      if (!keep(std::abs(values[i]))) continue;
+      values[write] = values[i];
+      rows[write] = rows[i];
+      write++;
+    }
+    kept = write;
+  };
+  if (drop.relative > 0 && kept > 0) {
+    Entry largest = 0;
+    for (int i = 0; i < kept; i++) largest = std::max<Entry>(largest, std::abs(values[i]));
+    const auto floor = static_cast<Entry>(drop.relative) * largest;
+    keep_if([&](Entry magnitude) { return magnitude >= floor; });
+  }
+  if (drop.top_k > 0 && kept > drop.top_k) {
+    // Everything above the top_k-th largest magnitude stays, plus as many entries equal to it as still fit.
+    std::vector<Entry> magnitudes(kept);
+    for (int i = 0; i < kept; i++) magnitudes[i] = std::abs(values[i]);
+    std::nth_element(magnitudes.begin(), magnitudes.begin() + (drop.top_k - 1), magnitudes.end(), std::greater<>());
+    const Entry cutoff = magnitudes[drop.top_k - 1];
+    auto ties = drop.top_k - static_cast<int>(std::ranges::count_if(magnitudes, [&](Entry m) { return m > cutoff; }));
+    keep_if([&](Entry magnitude) { return magnitude > cutoff || (magnitude == cutoff && ties-- > 0); });
+  }
+  return kept;
+}
+
+}  // namespace detail
+
+template <typename Value, typename Index, typename Policy>
+BasicSparseMatrix<Value, Index, Policy> BasicSparseMatrix<Value, Index, Policy>::ComputeTranspose(
+    const BasicSparseMatrix& matrix) {
+  auto values = matrix.GetValues();
+  auto row_indices = matrix.GetRowIndices();
+  auto cumulative = matrix.GetCumulativeElements();
+  int rows_count = matrix.GetRowCount();
+  int cols_count = matrix.GetColumnCount();
+
+  // Columns are split into contiguous chunks, one per thread; offsets[chunk * rows_count + row] first holds the
+  // chunk's histogram and then, after the prefix sum, the position where the chunk writes its first entry of that row.
+  int chunks_count = std::max(1, std::min(cols_count, Policy::Concurrency()));
+  auto chunk_begin = [&](int chunk) {
+    return static_cast<int>(static_cast<long long>(cols_count) * chunk / chunks_count);
+  };
+  std::vector<Index> offsets(static_cast<size_t>(chunks_count) * rows_count, 0);
+
+  Policy::ParallelFor(chunks_count, [&](int chunk) {
+    Index* counts = offsets.data() + (static_cast<size_t>(chunk) * rows_count);
+    Index first = chunk_begin(chunk) == 0 ? 0 : cumulative[chunk_begin(chunk) - 1];
+    Index last = chunk_begin(chunk + 1) == 0 ? 0 : cumulative[chunk_begin(chunk + 1) - 1];
+    for (Index i = first; i < last; i++) counts[row_indices[i]]++;
+  });
+
+  std::vector<Index> new_cumulative(rows_count, 0);
+  Index running = 0;
+  for (int row = 0; row < rows_count; row++) {
+    for (int chunk = 0; chunk < chunks_count; chunk++) {
+      Index& slot = offsets[(static_cast<size_t>(chunk) * rows_count) + row];
+      Index count = slot;
+      slot = running;
+      running += count;
+    }
+    new_cumulative[row] = running;
+  }
+
+  std::vector<Value> new_values(values.size());
+  std::vector<Index> new_rows(values.size());
+  Policy::ParallelFor(chunks_count, [&](int chunk) {
+    Index* next = offsets.data() + (static_cast<size_t>(chunk) * rows_count);
+    for (int col = chunk_begin(chunk); col < chunk_begin(chunk + 1); col++) {
+      Index start = col == 0 ? 0 : cumulative[col - 1];
+      for (Index i = start; i < cumulative[col]; i++) {
+        Index dst = next[row_indices[i]]++;
+        new_values[dst] = values[i];
+        new_rows[dst] = col;
+      }
+    }
+  });
+  return BasicSparseMatrix(cols_count, rows_count, std::move(new_values), std::move(new_rows),
+                           std::move(new_cumulative));
+}
+
+template <typename Value, typename Index, typename Policy>
+BasicSparseMatrix<Value, Index, Policy> MatrixToSparse(int rows_count, int columns_count, const Value* values) {
+  int tiles_count = (columns_count + detail::kTileColumns - 1) / detail::kTileColumns;
+  std::vector<Index> cumulative_elements(columns_count, 0);
+
+  Policy::ParallelFor(tiles_count, [&](int tile) {
+    int first_col = tile * detail::kTileColumns;
+    int last_col = std::min(columns_count, first_col + detail::kTileColumns);
+    detail::CountTile(values, rows_count, columns_count, first_col, last_col, cumulative_elements);
+  });
+
+  std::partial_sum(cumulative_elements.begin(), cumulative_elements.end(), cumulative_elements.begin());
+
+  Index nnz = cumulative_elements.empty() ? 0 : cumulative_elements.back();
+  std::vector<Value> sparse_values(nnz);
+  std::vector<Index> row_indices(nnz);
+
+  Policy::ParallelFor(tiles_count, [&](int tile) {
+    int first_col = tile * detail::kTileColumns;
+    int last_col = std::min(columns_count, first_col + detail::kTileColumns);
+    detail::FillTile(values, rows_count, columns_count, first_col, last_col, cumulative_elements, sparse_values,
+                     row_indices);
+  });
+  return BasicSparseMatrix<Value, Index, Policy>(rows_count, columns_count, std::move(sparse_values),
+                                                 std::move(row_indices), std::move(cumulative_elements));
+}
+
+template <typename Value, typename Index, typename Policy>
+BasicSparseMatrix<Value, Index, Policy> MatrixToSparse(int rows_count, int columns_count,
+                                                       const std::vector<Value>& values) {
+  return MatrixToSparse<Value, Index, Policy>(rows_count, columns_count, values.data());
+}
+
+template <typename Value, typename Index, typename Policy>
+std::vector<Value> FromSparseMatrix(const BasicSparseMatrix<Value, Index, Policy>& matrix) {
+  std::vector<Value> dense_matrix(static_cast<size_t>(matrix.GetRowCount()) * matrix.GetColumnCount(), 0);
+  auto values = matrix.GetValues();
+  auto row_indices = matrix.GetRowIndices();
+  auto cumulative = matrix.GetCumulativeElements();
+
+  int col = 0;
+  Index count = 0;
+  for (size_t i = 0; i < values.size(); i++) {
+    while (count == cumulative[col]) col++;
+    count++;
+    dense_matrix[(static_cast<size_t>(row_indices[i]) * matrix.GetColumnCount()) + col] = values[i];
+  }
+  return dense_matrix;
+}
+
+template <typename Value, typename Index, typename Policy>
+BasicSparseMatrix<Value, Index, Policy>::BasicSparseMatrix(int rows, int columns, std::vector<Value> values,
+                                                           std::vector<Index> rows_index,
+                                                           std::vector<Index> cumulative_sum)
+    : rows_count_(rows), cols_count_(columns) {
+  auto arrays = std::make_shared<SparseArrays<Value, Index>>(
+      SparseArrays<Value, Index>{std::move(values), std::move(rows_index), std::move(cumulative_sum)});
+  values_ = arrays->values;
+  row_indices_ = arrays->row_indices;
+  cumulative_elements_ = arrays->cumulative_elements;
+  storage_ = std::move(arrays);
+}
+
+template <typename Value, typename Index, typename Policy>
+Index BasicSparseMatrix<Value, Index, Policy>::CountElements(int index, std::span<const Index> elements_count) {
+  if (index == 0) return elements_count[index];
+  return elements_count[index] - elements_count[index - 1];
+}
+
+template <typename Value, typename Index, typename Policy>
+template <typename Accumulator>
+size_t BasicSparseMatrix<Value, Index, Policy>::AccumulateColumn(const BasicSparseMatrix& other, int col,
+                                                                 std::vector<Accumulator>& accumulator,
+                                                                 std::vector<int>& marker,
+                                                                 std::vector<int>& pattern) const {
+  pattern.clear();
+  auto second_sums = other.GetCumulativeElements();
+  Index second_start = col == 0 ? 0 : second_sums[col - 1];
+  size_t products = 0;
+
+  for (Index j = second_start; j < second_sums[col]; j++) {
+    Index inner = other.GetRowIndices()[j];
+    Accumulator second_value = other.GetValues()[j];
+    Index first_start = inner == 0 ? 0 : cumulative_elements_[inner - 1];
+    products += static_cast<size_t>(cumulative_elements_[inner] - first_start);
+
+    for (Index i = first_start; i < cumulative_elements_[inner]; i++) {
+      auto row = static_cast<int>(row_indices_[i]);
+      if (marker[row] != col) {
+        marker[row] = col;
+        pattern.push_back(row);
+      }
+      accumulator[row] += values_[i] * second_value;
+    }
+  }
+  std::sort(pattern.begin(), pattern.end());
+  return products;
+}
+
+template <typename Value, typename Index, typename Policy>
+int BasicSparseMatrix<Value, Index, Policy>::CountColumnNonZeros(const BasicSparseMatrix& other, int col,
+                                                                 std::vector<int>& marker) const {
+  auto second_sums = other.GetCumulativeElements();
+  Index second_start = col == 0 ? 0 : second_sums[col - 1];
+  int count = 0;
+
+  for (Index j = second_start; j < second_sums[col]; j++) {
+    Index inner = other.GetRowIndices()[j];
+    Index first_start = inner == 0 ? 0 : cumulative_elements_[inner - 1];
+    for (Index i = first_start; i < cumulative_elements_[inner]; i++) {
+      auto row = static_cast<int>(row_indices_[i]);
+      if (marker[row] != col) {
+        marker[row] = col;
+        count++;
+      }
+    }
+  }
+  return count;
+}
+
+template <typename Value, typename Index, typename Policy>
+template <typename Accumulator>
+int BasicSparseMatrix<Value, Index, Policy>::ComputeColumn(const BasicSparseMatrix& other, int col,
+                                                           std::vector<Accumulator>& accumulator,
+                                                           std::vector<int>& marker, std::vector<int>& pattern,
+                                                           Value* values, Index* rows, MultiplyStats& stats,
+                                                           const DropPolicy& drop) const {
+  size_t products = AccumulateColumn(other, col, accumulator, marker, pattern);
+  stats.flops += products;
+  stats.accumulator_hits += products - pattern.size();
+  int kept = 0;
+  for (int row : pattern) {
+    Accumulator sum = accumulator[row];
+    accumulator[row] = 0;
+    if (drop.Keeps(sum)) {
+      values[kept] = static_cast<Value>(sum);
+      rows[kept] = row;
+      kept++;
+    }
+  }
+  return detail::PruneColumn(values, rows, kept, drop);
+}
+
+template <typename Value, typename Index, typename Policy>
+template <typename Entry>
+int BasicSparseMatrix<Value, Index, Policy>::CountColumnNonZeros(const BasicSparseMatrix& other, int col,
+                                                                 size_t products,
+                                                                 HashAccumulator<Entry>& table) const {
+  auto second_sums = other.GetCumulativeElements();
+  Index second_start = col == 0 ? 0 : second_sums[col - 1];
+  table.Reset(products);
+
+  for (Index j = second_start; j < second_sums[col]; j++) {
+    Index inner = other.GetRowIndices()[j];
+    Index first_start = inner == 0 ? 0 : cumulative_elements_[inner - 1];
+    for (Index i = first_start; i < cumulative_elements_[inner]; i++) table[static_cast<int>(row_indices_[i])];
+  }
+  auto count = static_cast<int>(table.Size());
+  table.Clear();
+  return count;
+}
+
+template <typename Value, typename Index, typename Policy>
+template <typename Accumulator>
+int BasicSparseMatrix<Value, Index, Policy>::ComputeColumn(const BasicSparseMatrix& other, int col, size_t products,
+                                                           HashAccumulator<Accumulator>& table, Value* values,
+                                                           Index* rows, MultiplyStats& stats,
+                                                           const DropPolicy& drop) const {
+  auto second_sums = other.GetCumulativeElements();
+  Index second_start = col == 0 ? 0 : second_sums[col - 1];
+  table.Reset(products);
+
+  for (Index j = second_start; j < second_sums[col]; j++) {
+    Index inner = other.GetRowIndices()[j];
+    Accumulator second_value = other.GetValues()[j];
+    Index first_start = inner == 0 ? 0 : cumulative_elements_[inner - 1];
+    for (Index i = first_start; i < cumulative_elements_[inner]; i++) {
+      table[static_cast<int>(row_indices_[i])] += values_[i] * second_value;
+    }
+  }
+  stats.flops += products;
+  stats.accumulator_hits += products - table.Size();
+
+  int kept = 0;
+  table.ForEachSorted([&](int row, Accumulator sum) {
+    if (drop.Keeps(sum)) {
+      values[kept] = static_cast<Value>(sum);
+      rows[kept] = row;
+      kept++;
+    }
+  });
+  table.Clear();
+  return detail::PruneColumn(values, rows, kept, drop);
+}
+
+template <typename Value, typename Index, typename Policy>
+template <typename Element>
+void BasicSparseMatrix<Value, Index, Policy>::CompactColumns(std::vector<Element>& values, std::vector<Index>& rows,
+                                                             std::vector<Index>& cumulative,
+                                                             const std::vector<int>& kept) {
+  Index write = 0;
+  Index start = 0;
+  for (size_t col = 0; col < cumulative.size(); col++) {
+    Index end = cumulative[col];
+    if (write != start) {
+      std::copy(values.begin() + start, values.begin() + start + kept[col], values.begin() + write);
+      std::copy(rows.begin() + start, rows.begin() + start + kept[col], rows.begin() + write);
+    }
+    write += kept[col];
+    cumulative[col] = write;
+    start = end;
+  }
+  values.resize(write);
+  rows.resize(write);
+}
+
+template <typename Value, typename Index, typename Policy>
+template <typename Accumulator>
+BasicSparseMatrix<Value, Index, Policy> BasicSparseMatrix<Value, Index, Policy>::Multiply(
+    const BasicSparseMatrix& other, MultiplyStats* stats) const {
+  return Multiply<Accumulator>(other, DropPolicy{}, stats);
+}
+
+template <typename Value, typename Index, typename Policy>
+template <typename Accumulator>
+BasicSparseMatrix<Value, Index, Policy> BasicSparseMatrix<Value, Index, Policy>::Multiply(
+    const BasicSparseMatrix& other, const DropPolicy& drop, MultiplyStats* stats) const {
+  if (cols_count_ != other.rows_count_) {
+    throw std::invalid_argument("Matrix dimensions do not match for multiplication");
+  }
+  std::vector<Index> result_cumulative(other.GetColumnCount(), 0);
+  auto flops = detail::EstimateColumnFlops(*this, other);
+  auto bounds = PartitionColumns(flops, kBlocksPerThread * Policy::Concurrency());
+  int blocks_count = static_cast<int>(bounds.size()) - 1;
+
+  Policy::ParallelFor(blocks_count, [&](int block) {
+    std::vector<int> marker;
+    HashAccumulator<Value> table;
+    for (int col = bounds[block]; col < bounds[block + 1]; col++) {
+      if (PrefersHashAccumulator(flops[col])) {
+        result_cumulative[col] = CountColumnNonZeros(other, col, flops[col], table);
+      } else {
+        if (marker.empty()) marker.assign(rows_count_, -1);
+        result_cumulative[col] = CountColumnNonZeros(other, col, marker);
+      }
+    }
+  });
+
+  std::partial_sum(result_cumulative.begin(), result_cumulative.end(), result_cumulative.begin());
+  Index nnz = result_cumulative.empty() ? 0 : result_cumulative.back();
+  std::vector<Value> result_values(nnz);
+  std::vector<Index> result_rows(nnz);
+  std::vector<int> kept(other.GetColumnCount(), 0);
+
+  // Each block counts into its own stack copy and stores it once, so workers never share a counter line.
+  std::vector<MultiplyStats> block_stats(blocks_count);
+  Policy::ParallelFor(blocks_count, [&](int block) {
+    std::vector<Accumulator> accumulator;
+    std::vector<int> marker;
+    std::vector<int> pattern;
+    HashAccumulator<Accumulator> table;
+    MultiplyStats local;
+    for (int col = bounds[block]; col < bounds[block + 1]; col++) {
+      Index start = col == 0 ? 0 : result_cumulative[col - 1];
+      if (PrefersHashAccumulator(flops[col])) {
+        kept[col] = ComputeColumn(other, col, flops[col], table, result_values.data() + start,
+                                  result_rows.data() + start, local, drop);
+      } else {
+        if (accumulator.empty()) {
+          accumulator.assign(rows_count_, 0);
+          marker.assign(rows_count_, -1);
+        }
+        kept[col] = ComputeColumn(other, col, accumulator, marker, pattern, result_values.data() + start,
+                                  result_rows.data() + start, local, drop);
+      }
+    }
+    block_stats[block] = local;
+  });
+  MultiplyStats totals;
+  for (const auto& local : block_stats) totals += local;
+
+  CompactColumns(result_values, result_rows, result_cumulative, kept);
+  totals.output_nnz = result_values.size();
+  if (stats != nullptr) *stats = totals;
+  return BasicSparseMatrix(rows_count_, other.GetColumnCount(), std::move(result_values), std::move(result_rows),
+                           std::move(result_cumulative));
+}
+
+template <typename Value, typename Index, typename Policy>
+BasicSparseMatrix<Value, Index, Policy> BasicSparseMatrix<Value, Index, Policy>::operator*(
+    const BasicSparseMatrix& other) const {
+  return Multiply(other);
+}
+
+template <typename Value, typename Index, typename Policy>
+template <typename Accumulator>
+int BasicSparseMatrix<Value, Index, Policy>::DotColumn(const BasicSparseMatrix& transposed,
+                                                       const BasicSparseMatrix& other, int col,
+                                                       std::vector<Value>& values, std::vector<Index>& rows,
+                                                       const DropPolicy& drop) {
+  auto second_sums = other.GetCumulativeElements();
+  Index second_start = col == 0 ? 0 : second_sums[col - 1];
+  auto second_length = static_cast<size_t>(second_sums[col] - second_start);
+  if (second_length == 0) return 0;
+  auto second_rows = other.GetRowIndices().subspan(second_start, second_length);
+  auto second_values = other.GetValues().subspan(second_start, second_length);
+
+  auto first_sums = transposed.GetCumulativeElements();
+  size_t begin = values.size();
+  int kept = 0;
+  Index first_start = 0;
+  for (int row = 0; row < transposed.GetColumnCount(); row++) {
+    auto first_length = static_cast<size_t>(first_sums[row] - first_start);
+    auto sum = SparseDot<Accumulator>(transposed.GetRowIndices().subspan(first_start, first_length),
+                                      transposed.GetValues().subspan(first_start, first_length), second_rows,
+                                      second_values);
+    if (drop.Keeps(sum)) {
+      values.push_back(static_cast<Value>(sum));
+      rows.push_back(row);
+      kept++;
+    }
+    first_start = first_sums[row];
+  }
+  kept = detail::PruneColumn(values.data() + begin, rows.data() + begin, kept, drop);
+  values.resize(begin + kept);
+  rows.resize(begin + kept);
+  return kept;
+}
+
+template <typename Value, typename Index, typename Policy>
+template <typename Accumulator>
+BasicSparseMatrix<Value, Index, Policy> BasicSparseMatrix<Value, Index, Policy>::MultiplyInner(
+    const BasicSparseMatrix& other, const DropPolicy& drop) const {
+  if (cols_count_ != other.rows_count_) {
+    throw std::invalid_argument("Matrix dimensions do not match for multiplication");
+  }
+  auto transposed = ComputeTranspose(*this);
+  // Every column costs one pass over the rows of A plus its own length per row, so B's column lengths balance it.
+  auto bounds =
+      PartitionColumns(detail::ColumnLengths(other.GetCumulativeElements()), kBlocksPerThread * Policy::Concurrency());
+  int blocks_count = static_cast<int>(bounds.size()) - 1;
+
+  // Column sizes are known only once their dots are done, so each block appends to arrays of its own and the
+  // blocks are copied into place after the prefix sum.
+  std::vector<Index> result_cumulative(other.GetColumnCount(), 0);
+  std::vector<std::vector<Value>> block_values(blocks_count);
+  std::vector<std::vector<Index>> block_rows(blocks_count);
+  Policy::ParallelFor(blocks_count, [&](int block) {
+    for (int col = bounds[block]; col < bounds[block + 1]; col++) {
+      result_cumulative[col] =
+          DotColumn<Accumulator>(transposed, other, col, block_values[block], block_rows[block], drop);
+    }
+  });
+
+  std::partial_sum(result_cumulative.begin(), result_cumulative.end(), result_cumulative.begin());
+  Index nnz = result_cumulative.empty() ? 0 : result_cumulative.back();
+  std::vector<Value> result_values(nnz);
+  std::vector<Index> result_rows(nnz);
+  Policy::ParallelFor(blocks_count, [&](int block) {
+    Index start = bounds[block] == 0 ? 0 : result_cumulative[bounds[block] - 1];
+    std::ranges::copy(block_values[block], result_values.begin() + start);
+    std::ranges::copy(block_rows[block], result_rows.begin() + start);
+  });
+
+  return BasicSparseMatrix(rows_count_, other.GetColumnCount(), std::move(result_values), std::move(result_rows),
+                           std::move(result_cumulative));
+}
+
+template <typename Value, typename Index, typename Policy>
+template <typename Accumulator>
+BasicSparseMatrix<Value, Index, Policy> BasicSparseMatrix<Value, Index, Policy>::MultiplyTransposed(
+    const BasicSparseMatrix& other, const DropPolicy& drop) const {
+  if (rows_count_ != other.rows_count_) {
+    throw std::invalid_argument("Matrix dimensions do not match for transposed multiplication");
+  }
+  return ComputeTranspose(*this).template Multiply<Accumulator>(other, drop);
+}
+
+template <typename Value, typename Index, typename Policy>
+template <typename Accumulator>
+int BasicSparseMatrix<Value, Index, Policy>::MaskedColumn(const BasicSparseMatrix& transposed,
+                                                          const BasicSparseMatrix& other,
+                                                          const BasicSparseMatrix& mask, int col,
+                                                          std::vector<Accumulator>& accumulator,
+                                                          std::vector<int>& marker, Value* values, Index* rows,
+                                                          const DropPolicy& drop) const {
+  auto mask_sums = mask.GetCumulativeElements();
+  Index mask_start = col == 0 ? 0 : mask_sums[col - 1];
+  auto mask_rows = mask.GetRowIndices().subspan(mask_start, static_cast<size_t>(mask_sums[col] - mask_start));
+  auto second_sums = other.GetCumulativeElements();
+  Index second_start = col == 0 ? 0 : second_sums[col - 1];
+  auto second_length = static_cast<size_t>(second_sums[col] - second_start);
+  if (mask_rows.empty() || second_length == 0) return 0;
+  auto second_rows = other.GetRowIndices().subspan(second_start, second_length);
+  auto second_values = other.GetValues().subspan(second_start, second_length);
+
+  // A dot walks A(i, :) and B(:, col) once per mask entry; Gustavson walks every column of A that B(:, col) selects.
+  auto transposed_sums = transposed.GetCumulativeElements();
+  size_t dot_cost = 0;
+  for (Index row : mask_rows) {
+    dot_cost += static_cast<size_t>(CountElements(static_cast<int>(row), transposed_sums)) + second_length;
+  }
+  size_t scatter_cost = 0;
+  for (Index inner : second_rows) {
+    scatter_cost += static_cast<size_t>(CountElements(static_cast<int>(inner), cumulative_elements_));
+  }
+
+  int kept = 0;
+  if (dot_cost < scatter_cost) {
+    for (Index row : mask_rows) {
+      Index first_start = row == 0 ? 0 : transposed_sums[row - 1];
+      auto first_length = static_cast<size_t>(transposed_sums[row] - first_start);
+      auto sum = SparseDot<Accumulator>(transposed.GetRowIndices().subspan(first_start, first_length),
+                                        transposed.GetValues().subspan(first_start, first_length), second_rows,
+                                        second_values);
+      if (drop.Keeps(sum)) {
+        values[kept] = static_cast<Value>(sum);
+        rows[kept] = row;
+        kept++;
+      }
+    }
+    return detail::PruneColumn(values, rows, kept, drop);
+  }
+
+  if (accumulator.empty()) {
+    accumulator.assign(rows_count_, 0);
+    marker.assign(rows_count_, -1);
+  }
+  for (Index row : mask_rows) marker[row] = col;
+  for (size_t j = 0; j < second_length; j++) {
+    Index inner = second_rows[j];
+    Accumulator second_value = second_values[j];
+    Index first_start = inner == 0 ? 0 : cumulative_elements_[inner - 1];
+    for (Index i = first_start; i < cumulative_elements_[inner]; i++) {
+      if (marker[row_indices_[i]] == col) accumulator[row_indices_[i]] += values_[i] * second_value;
+    }
+  }
+  for (Index row : mask_rows) {
+    Accumulator sum = accumulator[row];
+    accumulator[row] = 0;
+    if (drop.Keeps(sum)) {
+      values[kept] = static_cast<Value>(sum);
+      rows[kept] = row;
+      kept++;
+    }
+  }
+  return detail::PruneColumn(values, rows, kept, drop);
+}
+
+template <typename Value, typename Index, typename Policy>
+template <typename Accumulator>
+BasicSparseMatrix<Value, Index, Policy> BasicSparseMatrix<Value, Index, Policy>::MultiplyMasked(
+    const BasicSparseMatrix& other, const BasicSparseMatrix& mask, const DropPolicy& drop) const {
+  if (mask.GetRowCount() != rows_count_ || mask.GetColumnCount() != other.GetColumnCount()) {
+    throw std::invalid_argument("Mask dimensions do not match the product");
+  }
+  auto transposed = ComputeTranspose(*this);
+  // C(:, col) holds at most the entries of mask(:, col), so the mask's offsets size the output up front.
+  auto mask_sums = mask.GetCumulativeElements();
+  std::vector<Index> result_cumulative(mask_sums.begin(), mask_sums.end());
+  Index capacity = result_cumulative.empty() ? 0 : result_cumulative.back();
+  std::vector<Value> result_values(capacity);
+  std::vector<Index> result_rows(capacity);
+  std::vector<int> kept(other.GetColumnCount(), 0);
+
+  // A column costs about one step per mask entry and per entry of B(:, col), whichever kernel it takes.
+  auto costs = detail::ColumnLengths(other.GetCumulativeElements());
+  std::ranges::transform(costs, detail::ColumnLengths(mask_sums), costs.begin(), std::plus<>());
+  auto bounds = PartitionColumns(costs, kBlocksPerThread * Policy::Concurrency());
+  int blocks_count = static_cast<int>(bounds.size()) - 1;
+
+  Policy::ParallelFor(blocks_count, [&](int block) {
+    std::vector<Accumulator> accumulator;
+    std::vector<int> marker;
+    for (int col = bounds[block]; col < bounds[block + 1]; col++) {
+      Index start = col == 0 ? 0 : result_cumulative[col - 1];
+      kept[col] = MaskedColumn<Accumulator>(transposed, other, mask, col, accumulator, marker,
+                                            result_values.data() + start, result_rows.data() + start, drop);
+    }
+  });
+
+  CompactColumns(result_values, result_rows, result_cumulative, kept);
+  return BasicSparseMatrix(rows_count_, other.GetColumnCount(), std::move(result_values), std::move(result_rows),
+                           std::move(result_cumulative));
+}
+
+template <typename Value, typename Index, typename Policy>
+int BasicSparseMatrix<Value, Index, Policy>::AddColumn(const BasicSparseMatrix& other, int col, Value* values,
+                                                       Index* rows) const {
+  Index first = col == 0 ? 0 : cumulative_elements_[col - 1];
+  Index second = col == 0 ? 0 : other.cumulative_elements_[col - 1];
+  Index first_end = cumulative_elements_[col];
+  Index second_end = other.cumulative_elements_[col];
+  int kept = 0;
+  auto keep = [&](Index row, Value value) {
+    if (std::abs(value) > kThreshold) {
+      values[kept] = value;
+      rows[kept] = row;
+      kept++;
+    }
+  };
+  while (first < first_end && second < second_end) {
+    Index first_row = row_indices_[first];
+    Index second_row = other.row_indices_[second];
+    if (first_row < second_row) {
+      keep(first_row, values_[first++]);
+    } else if (second_row < first_row) {
+      keep(second_row, other.values_[second++]);
+    } else {
+      keep(first_row, values_[first++] + other.values_[second++]);
+    }
+  }
+  for (; first < first_end; first++) keep(row_indices_[first], values_[first]);
+  for (; second < second_end; second++) keep(other.row_indices_[second], other.values_[second]);
+  return kept;
+}
+
+template <typename Value, typename Index, typename Policy>
+BasicSparseMatrix<Value, Index, Policy> BasicSparseMatrix<Value, Index, Policy>::operator+(
+    const BasicSparseMatrix& other) const {
+  if (rows_count_ != other.rows_count_ || cols_count_ != other.cols_count_) {
+    throw std::invalid_argument("Matrix dimensions do not match for addition");
+  }
+  // C(:, col) holds at most the entries of A(:, col) and B(:, col) together, so the summed offsets size the output.
+  std::vector<Index> result_cumulative(cols_count_);
+  std::ranges::transform(cumulative_elements_, other.cumulative_elements_, result_cumulative.begin(), std::plus<>());
+  Index capacity = result_cumulative.empty() ? 0 : result_cumulative.back();
+  std::vector<Value> result_values(capacity);
+  std::vector<Index> result_rows(capacity);
+  std::vector<int> kept(cols_count_, 0);
+
+  auto bounds = PartitionColumns(detail::ColumnLengths(std::span<const Index>(result_cumulative)),
+                                 kBlocksPerThread * Policy::Concurrency());
+  int blocks_count = static_cast<int>(bounds.size()) - 1;
+
+  Policy::ParallelFor(blocks_count, [&](int block) {
+    for (int col = bounds[block]; col < bounds[block + 1]; col++) {
+      Index start = col == 0 ? 0 : result_cumulative[col - 1];
+      kept[col] = AddColumn(other, col, result_values.data() + start, result_rows.data() + start);
+    }
+  });
+
+  CompactColumns(result_values, result_rows, result_cumulative, kept);
+  return BasicSparseMatrix(rows_count_, cols_count_, std::move(result_values), std::move(result_rows),
+                           std::move(result_cumulative));
+}
+
+template <typename Value, typename Index, typename Policy>
+BasicSparseMatrix<Value, Index, Policy>& BasicSparseMatrix<Value, Index, Policy>::operator+=(
+    const BasicSparseMatrix& other) {
+  *this = *this + other;
+  return *this;
+}
+
+template <typename Value, typename Index, typename Policy>
+BasicSparseMatrix<Value, Index, Policy> BasicSparseMatrix<Value, Index, Policy>::operator*(Value factor) const {
+  if (factor == 0) {
+    return BasicSparseMatrix(rows_count_, cols_count_, std::vector<Value>(), std::vector<Index>(),
+                             std::vector<Index>(cols_count_, 0));
+  }
+  auto scaled = std::make_shared<detail::ScaledArrays<Value>>();
+  scaled->values.resize(values_.size());
+  scaled->pattern = storage_;
+  // The loop is a pure stream over the values, so it is cut into even ranges.
+  ParallelForRanges<Policy>(values_.size(), [&](size_t first, size_t last) {
+    for (size_t i = first; i < last; i++) scaled->values[i] = values_[i] * factor;
+  });
+  std::span<const Value> values(scaled->values);
+  return BasicSparseMatrix(rows_count_, cols_count_, values, row_indices_, cumulative_elements_, std::move(scaled));
+}
+
+template <typename Value, typename Index, typename Policy>
+BasicSparseMatrix<Value, Index, Policy>& BasicSparseMatrix<Value, Index, Policy>::operator*=(Value factor) {
+  *this = *this * factor;
+  return *this;
+}
+
+template <typename Value, typename Index, typename Policy>
+void BasicSpGEMMPlan<Value, Index, Policy>::BuildColumn(const Matrix& first, const Matrix& second, int col,
+                                                        std::vector<int>& marker, std::vector<Index>& position,
+                                                        std::vector<int>& pattern) {
+  auto first_sums = first.GetCumulativeElements();
+  auto second_sums = second.GetCumulativeElements();
+  Index second_start = col == 0 ? 0 : second_sums[col - 1];
+
+  pattern.clear();
+  for (Index j = second_start; j < second_sums[col]; j++) {
+    Index inner = second.GetRowIndices()[j];
+    Index first_start = inner == 0 ? 0 : first_sums[inner - 1];
+    for (Index i = first_start; i < first_sums[inner]; i++) {
+      auto row = static_cast<int>(first.GetRowIndices()[i]);
+      if (marker[row] != col) {
+        marker[row] = col;
+        pattern.push_back(row);
+      }
+    }
+  }
+  std::sort(pattern.begin(), pattern.end());
+
+  Index start = col == 0 ? 0 : cumulative_elements_[col - 1];
+  for (size_t e = 0; e < pattern.size(); e++) {
+    row_indices_[start + e] = pattern[e];
+    position[pattern[e]] = start + static_cast<Index>(e);
+  }
+
+  size_t product = col == 0 ? 0 : scatter_cumulative_[col - 1];
+  for (Index j = second_start; j < second_sums[col]; j++) {
+    Index inner = second.GetRowIndices()[j];
+    Index first_start = inner == 0 ? 0 : first_sums[inner - 1];
+    for (Index i = first_start; i < first_sums[inner]; i++) scatter_[product++] = position[first.GetRowIndices()[i]];
+  }
+}
+
+template <typename Value, typename Index, typename Policy>
+void BasicSpGEMMPlan<Value, Index, Policy>::BuildColumn(const Matrix& first, const Matrix& second, int col,
+                                                        HashAccumulator<Index>& table) {
+  auto first_sums = first.GetCumulativeElements();
+  auto second_sums = second.GetCumulativeElements();
+  Index second_start = col == 0 ? 0 : second_sums[col - 1];
+  size_t first_product = col == 0 ? 0 : scatter_cumulative_[col - 1];
+  table.Reset(scatter_cumulative_[col] - first_product);
+
+  for (Index j = second_start; j < second_sums[col]; j++) {
+    Index inner = second.GetRowIndices()[j];
+    Index first_start = inner == 0 ? 0 : first_sums[inner - 1];
+    for (Index i = first_start; i < first_sums[inner]; i++) table[static_cast<int>(first.GetRowIndices()[i])];
+  }
+
+  // The table maps each output row to its slot in the column, which the scatter pass then looks up.
+  Index position = col == 0 ? 0 : cumulative_elements_[col - 1];
+  table.ForEachSorted([&](int row, Index& slot) {
+    row_indices_[position] = row;
+    slot = position++;
+  });
+
+  size_t product = first_product;
+  for (Index j = second_start; j < second_sums[col]; j++) {
+    Index inner = second.GetRowIndices()[j];
+    Index first_start = inner == 0 ? 0 : first_sums[inner - 1];
+    for (Index i = first_start; i < first_sums[inner]; i++) {
+      scatter_[product++] = table[static_cast<int>(first.GetRowIndices()[i])];
+    }
+  }
+  table.Clear();
+}
+
+template <typename Value, typename Index, typename Policy>
+template <typename Accumulator>
+int BasicSpGEMMPlan<Value, Index, Policy>::ComputeColumn(const Matrix& first, const Matrix& second, int col,
+                                                         std::vector<Accumulator>& values, std::vector<Index>& rows,
+                                                         MultiplyStats& stats, const DropPolicy& drop) const {
+  auto first_sums = first.GetCumulativeElements();
+  auto second_sums = second.GetCumulativeElements();
+  Index second_start = col == 0 ? 0 : second_sums[col - 1];
+
+  size_t first_product = col == 0 ? 0 : scatter_cumulative_[col - 1];
+  size_t product = first_product;
+  for (Index j = second_start; j < second_sums[col]; j++) {
+    Index inner = second.GetRowIndices()[j];
+    Accumulator second_value = second.GetValues()[j];
+    Index first_start = inner == 0 ? 0 : first_sums[inner - 1];
+    for (Index i = first_start; i < first_sums[inner]; i++) {
+      values[scatter_[product++]] += first.GetValues()[i] * second_value;
+    }
+  }
+
+  Index start = col == 0 ? 0 : cumulative_elements_[col - 1];
+  stats.flops += product - first_product;
+  stats.accumulator_hits += product - first_product - static_cast<size_t>(cumulative_elements_[col] - start);
+  int kept = 0;
+  for (Index e = start; e < cumulative_elements_[col]; e++) {
+    if (drop.Keeps(values[e])) {
+      values[start + kept] = values[e];
+      rows[start + kept] = row_indices_[e];
+      kept++;
+    }
+  }
+  return detail::PruneColumn(values.data() + start, rows.data() + start, kept, drop);
+}
+
+template <typename Value, typename Index, typename Policy>
+bool BasicSpGEMMPlan<Value, Index, Policy>::Matches(const Matrix& first, const Matrix& second) const noexcept {
+  return first.GetRowCount() == rows_count_ && second.GetColumnCount() == cols_count_ &&
+         std::ranges::equal(first.GetCumulativeElements(), first_cumulative_) &&
+         std::ranges::equal(second.GetCumulativeElements(), second_cumulative_) &&
+         std::ranges::equal(first.GetRowIndices(), first_rows_) &&
+         std::ranges::equal(second.GetRowIndices(), second_rows_);
+}
+
+template <typename Value, typename Index, typename Policy>
+BasicSpGEMMPlan<Value, Index, Policy>::BasicSpGEMMPlan(const Matrix& first, const Matrix& second)
+    : rows_count_(first.GetRowCount()),
+      cols_count_(second.GetColumnCount()),
+      cumulative_elements_(second.GetColumnCount(), 0),
+      scatter_cumulative_(second.GetColumnCount(), 0),
+      first_rows_(first.GetRowIndices().begin(), first.GetRowIndices().end()),
+      first_cumulative_(first.GetCumulativeElements().begin(), first.GetCumulativeElements().end()),
+      second_rows_(second.GetRowIndices().begin(), second.GetRowIndices().end()),
+      second_cumulative_(second.GetCumulativeElements().begin(), second.GetCumulativeElements().end()) {
+  if (first.GetColumnCount() != second.GetRowCount()) {
+    throw std::invalid_argument("Matrix dimensions do not match for multiplication");
+  }
+  std::vector<size_t> flops = detail::EstimateColumnFlops(first, second);
+  column_bounds_ = PartitionColumns(flops, kBlocksPerThread * Policy::Concurrency());
+  int blocks_count = static_cast<int>(column_bounds_.size()) - 1;
+
+  Policy::ParallelFor(blocks_count, [&](int block) {
+    std::vector<int> marker;
+    HashAccumulator<Index> table;
+    for (int col = column_bounds_[block]; col < column_bounds_[block + 1]; col++) {
+      if (first.PrefersHashAccumulator(flops[col])) {
+        cumulative_elements_[col] = first.CountColumnNonZeros(second, col, flops[col], table);
+      } else {
+        if (marker.empty()) marker.assign(rows_count_, -1);
+        cumulative_elements_[col] = first.CountColumnNonZeros(second, col, marker);
+      }
+    }
+  });
+  std::partial_sum(cumulative_elements_.begin(), cumulative_elements_.end(), cumulative_elements_.begin());
+  std::partial_sum(flops.begin(), flops.end(), scatter_cumulative_.begin());
+  row_indices_.resize(cumulative_elements_.empty() ? 0 : cumulative_elements_.back());
+  scatter_.resize(scatter_cumulative_.empty() ? 0 : scatter_cumulative_.back());
+
+  Policy::ParallelFor(blocks_count, [&](int block) {
+    std::vector<int> marker;
+    std::vector<Index> position;
+    std::vector<int> pattern;
+    HashAccumulator<Index> table;
+    for (int col = column_bounds_[block]; col < column_bounds_[block + 1]; col++) {
+      if (first.PrefersHashAccumulator(flops[col])) {
+        BuildColumn(first, second, col, table);
+      } else {
+        if (marker.empty()) {
+          marker.assign(rows_count_, -1);
+          position.assign(rows_count_, 0);
+        }
+        BuildColumn(first, second, col, marker, position, pattern);
+      }
+    }
+  });
+}
+
+template <typename Value, typename Index, typename Policy>
+template <typename Accumulator>
+MultiplyStats BasicSpGEMMPlan<Value, Index, Policy>::Compute(const Matrix& first, const Matrix& second,
+                                                             std::vector<Accumulator>& values,
+                                                             std::vector<Index>& rows, std::vector<Index>& cumulative,
+                                                             const DropPolicy& drop) const {
+  values.assign(row_indices_.size(), 0);
+  rows.resize(row_indices_.size());
+  cumulative.assign(cumulative_elements_.begin(), cumulative_elements_.end());
+  std::vector<int> kept(cols_count_, 0);
+  int blocks_count = static_cast<int>(column_bounds_.size()) - 1;
+
+  std::vector<MultiplyStats> block_stats(blocks_count);
+  Policy::ParallelFor(blocks_count, [&](int block) {
+    MultiplyStats local;
+    for (int col = column_bounds_[block]; col < column_bounds_[block + 1]; col++) {
+      kept[col] = ComputeColumn(first, second, col, values, rows, local, drop);
+    }
+    block_stats[block] = local;
+  });
+  MultiplyStats totals;
+  for (const auto& local : block_stats) totals += local;
+
+  Matrix::CompactColumns(values, rows, cumulative, kept);
+  totals.output_nnz = values.size();
+  return totals;
+}
+
+template <typename Value, typename Index, typename Policy>
+template <typename Accumulator>
+BasicSparseMatrix<Value, Index, Policy> BasicSpGEMMPlan<Value, Index, Policy>::Multiply(const Matrix& first,
+                                                                                        const Matrix& second,
+                                                                                        MultiplyStats* stats,
+                                                                                        const DropPolicy& drop) const {
+  std::vector<Accumulator> result_values;
+  std::vector<Index> result_rows;
+  std::vector<Index> result_cumulative;
+  MultiplyStats totals = Compute(first, second, result_values, result_rows, result_cumulative, drop);
+  if (stats != nullptr) *stats = totals;
+  if constexpr (std::is_same_v<Accumulator, Value>) {
+    return Matrix(rows_count_, cols_count_, std::move(result_values), std::move(result_rows),
+                  std::move(result_cumulative));
+  } else {
+    return Matrix(rows_count_, cols_count_, std::vector<Value>(result_values.begin(), result_values.end()),
+                  std::move(result_rows), std::move(result_cumulative));
+  }
+}
+
+template <typename Value, typename Index, typename Policy>
+BasicSparseMatrix<Value, Index, Policy> BasicSpGEMMPlan<Value, Index, Policy>::Multiply(
+    const Matrix& first, const Matrix& second, SparseArrays<Value, Index>& buffers, MultiplyStats* stats,
+    const DropPolicy& drop) const {
+  MultiplyStats totals =
+      Compute(first, second, buffers.values, buffers.row_indices, buffers.cumulative_elements, drop);
+  if (stats != nullptr) *stats = totals;
+  return Matrix(rows_count_, cols_count_, std::span<const Value>(buffers.values),
+                std::span<const Index>(buffers.row_indices), std::span<const Index>(buffers.cumulative_elements));
+}
+
+}  // namespace ppc::sparse
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "sparse/matrix/include/execution.hpp"
+#include "sparse/matrix/include/sparse_matrix.hpp"
+
+namespace ppc::sparse {
+
+// Right-hand sides one CSR row is accumulated for at a time, kept in registers across the row.
+constexpr int kVectorBlock = 8;
+
+// Y = A * X for a block of dense right-hand sides. X is a_cols x vectors and Y a_rows x vectors, both row-major, so
+// the vectors of one row sit side by side and a single pass over A serves the whole block. Both run under the policy
+// of the matrix.
+//
+// MultiplyCcs sweeps A by columns and scatters into Y. Parallel parts of the sweep may hit the same rows, so each
+// fills a private Y and the copies are summed at the end.
+template <typename Value, typename Index, typename Policy>
+void MultiplyCcs(const BasicSparseMatrix<Value, Index, Policy>& matrix, const Value* block, int vectors,
+                 Value* result);
+// MultiplyCsr takes A in CSR form, i.e. the CCS arrays of A^T from BasicSparseMatrix::ComputeTranspose, and gathers
+// one row of Y at a time from the rows of X its row of A selects. Rows are independent, so the parallel version needs
+// neither private copies nor a reduction.
+template <typename Value, typename Index, typename Policy>
+void MultiplyCsr(const BasicSparseMatrix<Value, Index, Policy>& transposed, const Value* block, int vectors,
+                 Value* result);
+
+namespace detail {
+
+template <int Width, typename Value, typename Index>
+void GatherRow(std::span<const Value> values, std::span<const Index> columns, const Value* block, int vectors,
+               int first, int width, Value* out) {
+  // Width is 0 for the ragged tail of the block, whose size is only known at run time.
+  constexpr int kCapacity = Width == 0 ? kVectorBlock : Width;
+  const int count = Width == 0 ? width : Width;
+  std::array<Value, kCapacity> sums{};
+  for (size_t e = 0; e < values.size(); e++) {
+    const Value* x = block + (static_cast<size_t>(columns[e]) * vectors) + first;
+    for (int v = 0; v < count; v++) sums[v] += values[e] * x[v];
+  }
+  std::copy_n(sums.begin(), count, out + first);
+}
+
+// Rows [first_row, last_row) of Y from the CSR form of A.
+template <typename Value, typename Index, typename Policy>
+void MultiplyRows(const BasicSparseMatrix<Value, Index, Policy>& transposed, const Value* block, int vectors,
+                  int first_row, int last_row, Value* result) {
+  auto sums = transposed.GetCumulativeElements();
+  for (int row = first_row; row < last_row; row++) {
+    Index start = row == 0 ? 0 : sums[row - 1];
+    auto length = static_cast<size_t>(sums[row] - start);
+    auto values = transposed.GetValues().subspan(start, length);
+    auto columns = transposed.GetRowIndices().subspan(start, length);
+    Value* out = result + (static_cast<size_t>(row) * vectors);
+    if (vectors == 1) {
+      GatherRow<1>(values, columns, block, vectors, 0, 1, out);
+      continue;
+    }
+    int first = 0;
+    for (; first + kVectorBlock <= vectors; first += kVectorBlock) {
+      GatherRow<kVectorBlock>(values, columns, block, vectors, first, kVectorBlock, out);
+    }
+    if (first < vectors) GatherRow<0>(values, columns, block, vectors, first, vectors - first, out);
+  }
+}
+
+// Adds columns [first_col, last_col) of A times the matching rows of X into result.
+template <typename Value, typename Index, typename Policy>
+void AccumulateColumns(const BasicSparseMatrix<Value, Index, Policy>& matrix, const Value* block, int vectors,
+                       int first_col, int last_col, Value* result) {
+  auto values = matrix.GetValues();
+  auto rows = matrix.GetRowIndices();
+  auto sums = matrix.GetCumulativeElements();
+  for (int col = first_col; col < last_col; col++) {
+    const Value* x = block + (static_cast<size_t>(col) * vectors);
+    for (Index e = col == 0 ? 0 : sums[col - 1]; e < sums[col]; e++) {
+      Value* y = result + (static_cast<size_t>(rows[e]) * vectors);
+      for (int v = 0; v < vectors; v++) y[v] += values[e] * x[v];
+    }
+  }
+}
+
+}  // namespace detail
+
+template <typename Value, typename Index, typename Policy>
+void MultiplyCcs(const BasicSparseMatrix<Value, Index, Policy>& matrix, const Value* block, int vectors,
+                 Value* result) {
+  auto entries = static_cast<size_t>(matrix.GetRowCount()) * vectors;
+  // A column scatters into any row of Y, so every part sums into a Y of its own and the copies are added up after.
+  // One part per thread bounds that extra memory by threads x |Y|.
+  auto bounds = PartitionColumns(detail::ColumnLengths(matrix.GetCumulativeElements()), Policy::Concurrency());
+  int parts_count = static_cast<int>(bounds.size()) - 1;
+  if (parts_count <= 1) {
+    std::fill_n(result, entries, Value{0});
+    detail::AccumulateColumns(matrix, block, vectors, 0, matrix.GetColumnCount(), result);
+    return;
+  }
+
+  std::vector<std::vector<Value>> partial(parts_count);
+  Policy::ParallelFor(parts_count, [&](int part) {
+    partial[part].assign(entries, 0);
+    detail::AccumulateColumns(matrix, block, vectors, bounds[part], bounds[part + 1], partial[part].data());
+  });
+
+  ParallelForRanges<Policy>(entries, [&](size_t first, size_t last) {
+    std::copy(partial[0].begin() + first, partial[0].begin() + last, result + first);
+    for (size_t copy = 1; copy < partial.size(); copy++) {
+      for (size_t i = first; i < last; i++) result[i] += partial[copy][i];
+    }
+  });
+}
+
+template <typename Value, typename Index, typename Policy>
+void MultiplyCsr(const BasicSparseMatrix<Value, Index, Policy>& transposed, const Value* block, int vectors,
+                 Value* result) {
+  // Rows write disjoint parts of Y, so blocks of rows balanced by their lengths run without any reduction.
+  auto bounds = PartitionColumns(detail::ColumnLengths(transposed.GetCumulativeElements()),
+                                 kBlocksPerThread * Policy::Concurrency());
+  int blocks_count = static_cast<int>(bounds.size()) - 1;
+  Policy::ParallelFor(blocks_count, [&](int part) {
+    detail::MultiplyRows(transposed, block, vectors, bounds[part], bounds[part + 1], result);
+  });
+}
+
+}  // namespace ppc::sparse
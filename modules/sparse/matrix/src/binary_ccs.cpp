@@ -0,0 +1,211 @@
+#include "sparse/matrix/include/binary_ccs.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ppc::sparse {
+
+namespace {
+
+uint64_t AlignUp(uint64_t offset) {
+  return (offset + kBinaryCCSAlignment - 1) / kBinaryCCSAlignment * kBinaryCCSAlignment;
+}
+
+void WritePadding(std::ofstream& out, uint64_t& offset) {
+  static constexpr char kZeros[kBinaryCCSAlignment] = {};
+  uint64_t aligned = AlignUp(offset);
+  out.write(kZeros, static_cast<std::streamsize>(aligned - offset));
+  offset = aligned;
+}
+
+template <typename T>
+void WriteArray(std::ofstream& out, uint64_t& offset, std::span<const T> data) {
+  WritePadding(out, offset);
+  out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size_bytes()));
+  offset += data.size_bytes();
+}
+
+// Read-only view of a whole file; unmapped on destruction.
+class FileMapping {
+ public:
+  explicit FileMapping(const std::string& path) {
+#ifdef _WIN32
+    file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                        nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) throw std::runtime_error("Cannot open binary CCS file: " + path);
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file_, &size) == 0) {
+      CloseHandle(file_);
+      throw std::runtime_error("Cannot stat binary CCS file: " + path);
+    }
+    size_ = static_cast<size_t>(size.QuadPart);
+    if (size_ == 0) return;
+    mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_ != nullptr) data_ = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+    if (data_ == nullptr) {
+      if (mapping_ != nullptr) CloseHandle(mapping_);
+      CloseHandle(file_);
+      throw std::runtime_error("Cannot map binary CCS file: " + path);
+    }
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Cannot open binary CCS file: " + path);
+    struct stat info {};
+    if (fstat(fd, &info) != 0) {
+      close(fd);
+      throw std::runtime_error("Cannot stat binary CCS file: " + path);
+    }
+    size_ = static_cast<size_t>(info.st_size);
+    if (size_ != 0) data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file.
+    close(fd);
+    if (data_ == MAP_FAILED) {
+      data_ = nullptr;
+      throw std::runtime_error("Cannot map binary CCS file: " + path);
+    }
+#endif
+  }
+
+  FileMapping(const FileMapping&) = delete;
+  FileMapping& operator=(const FileMapping&) = delete;
+
+  ~FileMapping() {
+#ifdef _WIN32
+    if (data_ != nullptr) UnmapViewOfFile(data_);
+    if (mapping_ != nullptr) CloseHandle(mapping_);
+    CloseHandle(file_);
+#else
+    if (data_ != nullptr) munmap(data_, size_);
+#endif
+  }
+
+  [[nodiscard]] const std::byte* Data() const noexcept { return static_cast<const std::byte*>(data_); }
+  [[nodiscard]] size_t Size() const noexcept { return size_; }
+
+ private:
+#ifdef _WIN32
+  HANDLE file_ = INVALID_HANDLE_VALUE;
+  HANDLE mapping_ = nullptr;
+#endif
+  void* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+bool ArrayFits(uint64_t offset, uint64_t count, size_t element_size, size_t file_size) {
+  if (offset % kBinaryCCSAlignment != 0 || offset > file_size) return false;
+  return count <= (file_size - offset) / element_size;
+}
+
+}  // namespace
+
+template <typename Index>
+void WriteBinaryCCS(const std::string& path, const BasicSparseMatrix<double, Index>& matrix) {
+  std::ofstream out(path, std::ios::binary);
+  if (!out.is_open()) throw std::runtime_error("Cannot open binary CCS file for writing: " + path);
+
+  auto values = matrix.GetValues();
+  auto row_indices = matrix.GetRowIndices();
+  auto cumulative = matrix.GetCumulativeElements();
+
+  BinaryCCSHeader header{};
+  std::memcpy(header.magic, kBinaryCCSMagic, sizeof(header.magic));
+  header.version = kBinaryCCSVersion;
+  header.index_bytes = sizeof(Index);
+  header.rows_count = matrix.GetRowCount();
+  header.columns_count = matrix.GetColumnCount();
+  header.nnz = static_cast<int64_t>(values.size());
+  header.values_offset = AlignUp(sizeof(header));
+  header.row_indices_offset = AlignUp(header.values_offset + values.size_bytes());
+  header.cumulative_offset = AlignUp(header.row_indices_offset + row_indices.size_bytes());
+
+  uint64_t offset = sizeof(header);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  WriteArray(out, offset, values);
+  WriteArray(out, offset, row_indices);
+  WriteArray(out, offset, cumulative);
+  if (!out) throw std::runtime_error("Failed to write binary CCS file: " + path);
+}
+
+template <typename Index>
+BasicSparseMatrix<double, Index> MapBinaryCCS(const std::string& path) {
+  auto mapping = std::make_shared<const FileMapping>(path);
+  if (mapping->Size() < sizeof(BinaryCCSHeader)) throw std::runtime_error("Truncated binary CCS file: " + path);
+
+  BinaryCCSHeader header{};
+  std::memcpy(&header, mapping->Data(), sizeof(header));
+  if (std::memcmp(header.magic, kBinaryCCSMagic, sizeof(header.magic)) != 0) {
+    throw std::runtime_error("Not a binary CCS file: " + path);
+  }
+  if (header.version != kBinaryCCSVersion || (header.index_bytes != sizeof(int) && header.index_bytes != 8)) {
+    throw std::runtime_error("Unsupported binary CCS version or index width: " + path);
+  }
+  if (header.index_bytes != sizeof(Index)) {
+    throw std::runtime_error("Binary CCS file holds " + std::to_string(header.index_bytes) + "-byte indices, not " +
+                             std::to_string(sizeof(Index)) + "-byte ones: " + path);
+  }
+  // Dimensions are int whatever the index type; only nnz may grow with it.
+  constexpr int64_t kMaxDimension = std::numeric_limits<int>::max();
+  constexpr int64_t kMaxIndex = std::numeric_limits<Index>::max();
+  if (header.rows_count < 0 || header.rows_count > kMaxDimension || header.columns_count < 0 ||
+      header.columns_count > kMaxDimension || header.nnz < 0 || header.nnz > kMaxIndex) {
+    throw std::runtime_error("Invalid binary CCS dimensions: " + path);
+  }
+  const auto nnz = static_cast<size_t>(header.nnz);
+  const auto columns_count = static_cast<size_t>(header.columns_count);
+  if (!ArrayFits(header.values_offset, nnz, sizeof(double), mapping->Size()) ||
+      !ArrayFits(header.row_indices_offset, nnz, sizeof(Index), mapping->Size()) ||
+      !ArrayFits(header.cumulative_offset, columns_count, sizeof(Index), mapping->Size())) {
+    throw std::runtime_error("Truncated binary CCS file: " + path);
+  }
+
+  const std::byte* base = mapping->Data();
+  std::span<const double> values(reinterpret_cast<const double*>(base + header.values_offset), nnz);
+  std::span<const Index> row_indices(reinterpret_cast<const Index*>(base + header.row_indices_offset), nnz);
+  std::span<const Index> cumulative(reinterpret_cast<const Index*>(base + header.cumulative_offset), columns_count);
+  // The kernels index rows_count-sized scratch arrays with the row indices, so they are checked like the counts.
+  Index previous = 0;
+  for (Index count : cumulative) {
+    if (count < previous || static_cast<size_t>(count) > nnz) {
+      throw std::runtime_error("Invalid column counts in binary CCS file: " + path);
+    }
+    for (Index i = previous; i < count; i++) {
+      bool unordered = i > previous && row_indices[i] <= row_indices[i - 1];
+      if (row_indices[i] < 0 || row_indices[i] >= header.rows_count || unordered) {
+        throw std::runtime_error("Row indices out of range or order in binary CCS file: " + path);
+      }
+    }
+    previous = count;
+  }
+  if (static_cast<size_t>(previous) != nnz) throw std::runtime_error("Column counts do not match nnz: " + path);
+
+  return BasicSparseMatrix<double, Index>(static_cast<int>(header.rows_count), static_cast<int>(header.columns_count),
+                                          values, row_indices, cumulative, std::move(mapping));
+}
+
+template void WriteBinaryCCS(const std::string& path, const BasicSparseMatrix<double, int>& matrix);
+template void WriteBinaryCCS(const std::string& path, const BasicSparseMatrix<double, std::int64_t>& matrix);
+template BasicSparseMatrix<double, int> MapBinaryCCS(const std::string& path);
+template BasicSparseMatrix<double, std::int64_t> MapBinaryCCS(const std::string& path);
+
+}  // namespace ppc::sparse
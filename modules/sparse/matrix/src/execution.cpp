@@ -0,0 +1,30 @@
+#include "sparse/matrix/include/execution.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace ppc::sparse {
+
+std::vector<int> PartitionColumns(const std::vector<size_t>& column_costs, int parts) {
+  int columns_count = static_cast<int>(column_costs.size());
+  if (columns_count == 0) return {0};
+  parts = std::max(1, std::min(parts, columns_count));
+  // Every column also pays a fixed setup cost, which keeps runs of empty columns from piling into one range.
+  std::vector<size_t> prefix(columns_count + 1, 0);
+  for (int col = 0; col < columns_count; col++) prefix[col + 1] = prefix[col] + column_costs[col] + 1;
+
+  std::vector<int> bounds{0};
+  for (int part = 1; part < parts; part++) {
+    auto target = static_cast<size_t>(static_cast<long double>(prefix.back()) * part / parts);
+    auto col = static_cast<int>(std::lower_bound(prefix.begin(), prefix.end(), target) - prefix.begin());
+    // Cut on whichever side of the column crossing the target lands closer, so a heavy column is split off
+    // from the light ones before it instead of absorbing them.
+    if (col > 0 && target - prefix[col - 1] < prefix[col] - target) col--;
+    if (col > bounds.back() && col < columns_count) bounds.push_back(col);
+  }
+  bounds.push_back(columns_count);
+  return bounds;
+}
+
+}  // namespace ppc::sparse
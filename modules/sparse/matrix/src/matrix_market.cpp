@@ -0,0 +1,131 @@
+#include "sparse/matrix/include/matrix_market.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <istream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ppc::sparse {
+
+namespace detail {
+
+MarketHeader ReadMarketHeader(std::istream& in, const std::string& path) {
+  std::string line;
+  if (!std::getline(in, line)) throw std::runtime_error("Empty Matrix Market file: " + path);
+
+  std::istringstream banner(line);
+  std::string magic;
+  std::string object;
+  std::string format;
+  std::string field;
+  std::string symmetry;
+  banner >> magic >> object >> format >> field >> symmetry;
+  for (auto* word : {&object, &format, &field, &symmetry}) {
+    std::transform(word->begin(), word->end(), word->begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  }
+  if (magic != "%%MatrixMarket" || object != "matrix" || format != "coordinate") {
+    throw std::runtime_error("Unsupported Matrix Market banner in " + path + ": " + line);
+  }
+  if (field != "real" && field != "integer" && field != "pattern") {
+    throw std::runtime_error("Unsupported Matrix Market field in " + path + ": " + field);
+  }
+  if (symmetry != "general" && symmetry != "symmetric") {
+    throw std::runtime_error("Unsupported Matrix Market symmetry in " + path + ": " + symmetry);
+  }
+
+  MarketHeader header;
+  header.pattern = field == "pattern";
+  header.symmetric = symmetry == "symmetric";
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '%') continue;
+    std::istringstream sizes(line);
+    // Read signed, so that a negative count is rejected rather than wrapped.
+    long long entries_count = 0;
+    if (!(sizes >> header.rows_count >> header.columns_count >> entries_count) || header.rows_count < 0 ||
+        header.columns_count < 0 || entries_count < 0) {
+      throw std::runtime_error("Malformed Matrix Market size line in " + path + ": " + line);
+    }
+    header.entries_count = static_cast<size_t>(entries_count);
+    return header;
+  }
+  throw std::runtime_error("Missing Matrix Market size line in " + path);
+}
+
+size_t ParseMarketLines(const char* begin, const char* end, const MarketHeader& header,
+                        std::vector<MarketEntry>& out) {
+  size_t lines = 0;
+  const char* cursor = begin;
+  while (cursor < end) {
+    const char* line_end = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+    if (line_end == nullptr) line_end = end;
+    const char* first = cursor;
+    while (first < line_end && (*first == ' ' || *first == '\t' || *first == '\r')) first++;
+    if (first < line_end && *first != '%') {
+      char* next = nullptr;
+      long row = std::strtol(first, &next, 10);
+      long col = std::strtol(next, &next, 10);
+      const char* value_start = next;
+      double value = header.pattern ? 1.0 : std::strtod(next, &next);
+      bool missing_value = !header.pattern && next == value_start;
+      if (next > line_end || missing_value || row < 1 || row > header.rows_count || col < 1 ||
+          col > header.columns_count) {
+        throw std::runtime_error("Malformed Matrix Market entry: " + std::string(first, line_end));
+      }
+      lines++;
+      // Small parts of a repeated entry may add up to more than kThreshold, so zeros are only dropped once
+      // SumDuplicateEntries has folded the repeats.
+      out.push_back({static_cast<int>(row - 1), static_cast<int>(col - 1), value});
+      if (header.symmetric && row != col) {
+        out.push_back({static_cast<int>(col - 1), static_cast<int>(row - 1), value});
+      }
+    }
+    cursor = line_end + 1;
+  }
+  return lines;
+}
+
+size_t ReservedEntries(std::istream& in, const MarketHeader& header) {
+  auto capacity = std::min<std::uint64_t>(header.entries_count,
+                                          static_cast<std::uint64_t>(header.rows_count) * header.columns_count);
+  auto body_start = in.tellg();
+  if (in.seekg(0, std::ios::end)) {
+    // No entry line is shorter than "1 1\n".
+    capacity = std::min<std::uint64_t>(capacity, static_cast<std::uint64_t>(in.tellg() - body_start) / 4);
+  }
+  in.clear();
+  in.seekg(body_start);
+  return static_cast<size_t>(header.symmetric ? 2 * capacity : capacity);
+}
+
+}  // namespace detail
+
+void WriteMatrixMarket(const std::string& path, const SparseMatrix& matrix) {
+  std::ofstream out(path, std::ios::binary);
+  if (!out.is_open()) throw std::runtime_error("Cannot open Matrix Market file for writing: " + path);
+
+  const auto& values = matrix.GetValues();
+  const auto& row_indices = matrix.GetRowIndices();
+  const auto& cumulative = matrix.GetCumulativeElements();
+  out << "%%MatrixMarket matrix coordinate real general\n";
+  out << matrix.GetRowCount() << ' ' << matrix.GetColumnCount() << ' ' << values.size() << '\n';
+  out << std::setprecision(std::numeric_limits<double>::max_digits10);
+  for (int col = 0; col < matrix.GetColumnCount(); col++) {
+    int start = col == 0 ? 0 : cumulative[col - 1];
+    for (int i = start; i < cumulative[col]; i++) {
+      out << row_indices[i] + 1 << ' ' << col + 1 << ' ' << values[i] << '\n';
+    }
+  }
+  if (!out) throw std::runtime_error("Failed to write Matrix Market file: " + path);
+}
+
+}  // namespace ppc::sparse
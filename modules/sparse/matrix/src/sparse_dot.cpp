@@ -0,0 +1,176 @@
+#include "sparse/matrix/include/sparse_dot.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SPARSE_DOT_X86 1
+#endif
+
+namespace ppc::sparse {
+
+namespace {
+
+// Branch-free merge: both cursors advance on equal indices, only the smaller one otherwise.
+template <typename Accumulator, typename Value, typename Index>
+Accumulator ScalarDot(const Index* first_indices, const Value* first_values, size_t first_size,
+                      const Index* second_indices, const Value* second_values, size_t second_size, size_t p = 0,
+                      size_t q = 0, Accumulator sum = 0) {
+  while (p < first_size && q < second_size) {
+    Index a = first_indices[p];
+    Index b = second_indices[q];
+    if (a == b) sum += static_cast<Accumulator>(first_values[p]) * second_values[q];
+    p += a <= b ? 1 : 0;
+    q += b <= a ? 1 : 0;
+  }
+  return sum;
+}
+
+#ifdef SPARSE_DOT_X86
+
+// Both kernels compare a block of the first list against every rotation of a block of the second, look up the
+// partner lane of each hit, then step past whichever block ends lower (both on a tie). Lists are strictly
+// increasing, so no pair is seen twice; the tails finish in the scalar merge.
+template <typename Accumulator, typename Value>
+__attribute__((target("avx2"))) Accumulator Avx2Dot(const int* first_indices, const Value* first_values,
+                                                    size_t first_size, const int* second_indices,
+                                                    const Value* second_values, size_t second_size) {
+  constexpr size_t kLanes = 8;
+  const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+  Accumulator sum = 0;
+  size_t p = 0;
+  size_t q = 0;
+  while (p + kLanes <= first_size && q + kLanes <= second_size) {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first_indices + p));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second_indices + q));
+    __m256i hits = _mm256_cmpeq_epi32(a, b);
+    __m256i rotated = b;
+    for (size_t r = 1; r < kLanes; r++) {
+      rotated = _mm256_permutevar8x32_epi32(rotated, rotate);
+      hits = _mm256_or_si256(hits, _mm256_cmpeq_epi32(a, rotated));
+    }
+    auto mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(hits)));
+    while (mask != 0) {
+      auto lane = static_cast<size_t>(__builtin_ctz(mask));
+      mask &= mask - 1;
+      __m256i partner = _mm256_cmpeq_epi32(_mm256_set1_epi32(first_indices[p + lane]), b);
+      auto partner_lane = static_cast<size_t>(__builtin_ctz(_mm256_movemask_ps(_mm256_castsi256_ps(partner))));
+      sum += static_cast<Accumulator>(first_values[p + lane]) * second_values[q + partner_lane];
+    }
+    int a_last = first_indices[p + kLanes - 1];
+    int b_last = second_indices[q + kLanes - 1];
+    p += a_last <= b_last ? kLanes : 0;
+    q += b_last <= a_last ? kLanes : 0;
+  }
+  return ScalarDot<Accumulator>(first_indices, first_values, first_size, second_indices, second_values, second_size,
+                                p, q, sum);
+}
+
+template <typename Accumulator, typename Value>
+__attribute__((target("avx512f"))) Accumulator Avx512Dot(const int* first_indices, const Value* first_values,
+                                                         size_t first_size, const int* second_indices,
+                                                         const Value* second_values, size_t second_size) {
+  constexpr size_t kLanes = 16;
+  const __m512i rotate = _mm512_setr_epi32(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0);
+  Accumulator sum = 0;
+  size_t p = 0;
+  size_t q = 0;
+  while (p + kLanes <= first_size && q + kLanes <= second_size) {
+    __m512i a = _mm512_loadu_si512(first_indices + p);
+    __m512i b = _mm512_loadu_si512(second_indices + q);
+    __mmask16 hits = _mm512_cmpeq_epi32_mask(a, b);
+    __m512i rotated = b;
+    for (size_t r = 1; r < kLanes; r++) {
+      // Zero-masked form: the unmasked intrinsic trips -Wmaybe-uninitialized on its undefined pass-through in GCC 12.
+      rotated = _mm512_maskz_permutexvar_epi32(static_cast<__mmask16>(0xFFFF), rotate, rotated);
+      hits = static_cast<__mmask16>(hits | _mm512_cmpeq_epi32_mask(a, rotated));
+    }
+    auto mask = static_cast<unsigned>(hits);
+    while (mask != 0) {
+      auto lane = static_cast<size_t>(__builtin_ctz(mask));
+      mask &= mask - 1;
+      auto partner = static_cast<unsigned>(_mm512_cmpeq_epi32_mask(_mm512_set1_epi32(first_indices[p + lane]), b));
+      sum += static_cast<Accumulator>(first_values[p + lane]) * second_values[q + __builtin_ctz(partner)];
+    }
+    int a_last = first_indices[p + kLanes - 1];
+    int b_last = second_indices[q + kLanes - 1];
+    p += a_last <= b_last ? kLanes : 0;
+    q += b_last <= a_last ? kLanes : 0;
+  }
+  return ScalarDot<Accumulator>(first_indices, first_values, first_size, second_indices, second_values, second_size,
+                                p, q, sum);
+}
+
+#endif
+
+enum class DotKernel : std::uint8_t { kScalar, kAvx2, kAvx512 };
+
+DotKernel DetectDotKernel() {
+#ifdef SPARSE_DOT_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return DotKernel::kAvx512;
+  if (__builtin_cpu_supports("avx2")) return DotKernel::kAvx2;
+#endif
+  return DotKernel::kScalar;
+}
+
+DotKernel SelectedDotKernel() {
+  static const DotKernel kKernel = DetectDotKernel();
+  return kKernel;
+}
+
+}  // namespace
+
+template <typename Accumulator, typename Value, typename Index>
+Accumulator SparseDot(std::span<const Index> first_indices, std::span<const Value> first_values,
+                      std::span<const Index> second_indices, std::span<const Value> second_values) {
+  // Disjoint index ranges are common between a short row of A and a short column of B.
+  if (first_indices.empty() || second_indices.empty() || first_indices.back() < second_indices.front() ||
+      second_indices.back() < first_indices.front()) {
+    return 0;
+  }
+#ifdef SPARSE_DOT_X86
+  if constexpr (std::is_same_v<Index, int>) {
+    switch (SelectedDotKernel()) {
+      case DotKernel::kAvx512:
+        return Avx512Dot<Accumulator>(first_indices.data(), first_values.data(), first_indices.size(),
+                                      second_indices.data(), second_values.data(), second_indices.size());
+      case DotKernel::kAvx2:
+        return Avx2Dot<Accumulator>(first_indices.data(), first_values.data(), first_indices.size(),
+                                    second_indices.data(), second_values.data(), second_indices.size());
+      case DotKernel::kScalar:
+        break;
+    }
+  }
+#endif
+  return ScalarDot<Accumulator>(first_indices.data(), first_values.data(), first_indices.size(),
+                                second_indices.data(), second_values.data(), second_indices.size());
+}
+
+const char* SparseDotKernel() {
+  switch (SelectedDotKernel()) {
+    case DotKernel::kAvx512:
+      return "avx512";
+    case DotKernel::kAvx2:
+      return "avx2";
+    case DotKernel::kScalar:
+      break;
+  }
+  return "scalar";
+}
+
+template float SparseDot(std::span<const int>, std::span<const float>, std::span<const int>, std::span<const float>);
+template double SparseDot(std::span<const int>, std::span<const float>, std::span<const int>, std::span<const float>);
+template double SparseDot(std::span<const int>, std::span<const double>, std::span<const int>,
+                          std::span<const double>);
+template float SparseDot(std::span<const std::int64_t>, std::span<const float>, std::span<const std::int64_t>,
+                         std::span<const float>);
+template double SparseDot(std::span<const std::int64_t>, std::span<const float>, std::span<const std::int64_t>,
+                          std::span<const float>);
+template double SparseDot(std::span<const std::int64_t>, std::span<const double>, std::span<const std::int64_t>,
+                          std::span<const double>);
+
+}  // namespace ppc::sparse
@@ -0,0 +1,34 @@
+#include "sparse/matrix/include/sparse_matrix.hpp"
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "core/util/include/dense_gemm.hpp"
+#include "core/util/include/thread_pool.hpp"
+
+namespace ppc::sparse {
+
+std::vector<double> MultiplyMatrices(const std::vector<double>& first_matrix, int first_rows, int first_columns,
+                                     const std::vector<double>& second_matrix, int second_rows, int second_columns) {
+  if (first_columns != second_rows) throw std::invalid_argument("Matrix dimensions do not match for multiplication");
+  return ppc::util::MultiplyDense(first_matrix, second_matrix, first_rows, first_columns, second_columns,
+                                  &ppc::util::ThreadPool::Shared());
+}
+
+template <typename Value>
+std::vector<Value> GenerateRandomMatrix(int dimension) {
+  std::vector<Value> data(dimension);
+  std::mt19937 generator(std::random_device{}());
+
+  for (auto& val : data) {
+    val = static_cast<Value>(generator() % 500);
+    if (val > 250) val = 0;
+  }
+  return data;
+}
+
+template std::vector<float> GenerateRandomMatrix(int);
+template std::vector<double> GenerateRandomMatrix(int);
+
+}  // namespace ppc::sparse
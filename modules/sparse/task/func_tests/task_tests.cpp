@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+#include "sparse/matrix/include/execution.hpp"
+#include "sparse/matrix/include/execution_stl.hpp"
+#include "sparse/matrix/include/sparse_matrix.hpp"
+#include "sparse/task/include/ccs_matrix_task.hpp"
+#include "sparse/task/include/chain_task.hpp"
+
+namespace {
+
+template <typename Policy>
+std::vector<double> RunDenseTask(std::vector<double>& first, std::vector<double>& second, int size) {
+  std::vector<double> out(static_cast<size_t>(size) * size, 0);
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(first.data()));
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(second.data()));
+  for (int i = 0; i < 4; i++) task_data->inputs_count.emplace_back(size);
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  ppc::sparse::CCSMatrixTask<Policy> task(task_data);
+  EXPECT_TRUE(task.Validation());
+  task.PreProcessing();
+  task.Run();
+  task.PostProcessing();
+  return out;
+}
+
+}  // namespace
+
+TEST(sparse_task_module, sequential_task_matches_dense_oracle) {
+  const int size = 20;
+  auto first = ppc::sparse::GenerateRandomMatrix(size * size);
+  auto second = ppc::sparse::GenerateRandomMatrix(size * size);
+  auto expected = ppc::sparse::MultiplyMatrices(first, size, size, second, size, size);
+  EXPECT_EQ(RunDenseTask<ppc::sparse::SequentialPolicy>(first, second, size), expected);
+}
+
+TEST(sparse_task_module, thread_pool_task_matches_sequential_task) {
+  const int size = 35;
+  auto first = ppc::sparse::GenerateRandomMatrix(size * size);
+  auto second = ppc::sparse::GenerateRandomMatrix(size * size);
+  EXPECT_EQ(RunDenseTask<ppc::sparse::ThreadPoolPolicy>(first, second, size),
+            RunDenseTask<ppc::sparse::SequentialPolicy>(first, second, size));
+}
+
+TEST(sparse_task_module, thread_pool_chain_task_matches_pairwise_tasks) {
+  const int size = 30;
+  auto first = ppc::sparse::GenerateRandomMatrix(size * size);
+  auto second = ppc::sparse::GenerateRandomMatrix(size * size);
+  auto third = ppc::sparse::GenerateRandomMatrix(size * size);
+  auto pairwise = RunDenseTask<ppc::sparse::SequentialPolicy>(first, second, size);
+  pairwise = RunDenseTask<ppc::sparse::SequentialPolicy>(pairwise, third, size);
+
+  std::vector<double> out(static_cast<size_t>(size) * size, 0);
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  for (auto* operand : {&first, &second, &third}) {
+    task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(operand->data()));
+  }
+  for (int i = 0; i < 6; i++) task_data->inputs_count.emplace_back(size);
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  ppc::sparse::ChainProductTask<ppc::sparse::ThreadPoolPolicy> task(task_data);
+  ASSERT_TRUE(task.Validation());
+  task.PreProcessing();
+  task.Run();
+  task.PostProcessing();
+  EXPECT_EQ(out, pairwise);
+  EXPECT_EQ(task.GetPlan().GetSteps().size(), 2U);
+}
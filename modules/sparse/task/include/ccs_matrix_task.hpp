@@ -0,0 +1,350 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+#include "sparse/matrix/include/csr_matrix.hpp"
+#include "sparse/matrix/include/sparse_matrix.hpp"
+
+namespace ppc::sparse {
+
+// TaskData layouts accepted by CCSMatrixTask:
+//   dense input:   inputs = {A, B} as row-major doubles, inputs_count = {a_rows, a_cols, b_rows, b_cols};
+//   sparse input:  inputs = {A values, A row indices, A cumulative counts, B values, B row indices, B cumulative
+//                  counts} in SparseMatrix form, inputs_count = {a_rows, a_cols, b_rows, b_cols, a_nnz, b_nnz};
+//   dense output:  outputs = {C} with room for a_rows * b_cols doubles;
+//   sparse output: outputs = {values, row indices, cumulative counts}, outputs_count = {values capacity,
+//                  row indices capacity, b_cols}. PostProcessing sets outputs_count[0] and [1] to C's nnz;
+//   mask:          either input layout may be followed by {M values, M row indices, M cumulative counts}, an
+//                  a_rows x b_cols matrix in SparseMatrix form, with m_nnz appended to inputs_count. C is then
+//                  computed only on M's pattern.
+// A kCsr task reads and writes every sparse array above in CSR form instead: values, column indices and cumulative
+// row counts, so the cumulative counts of A, B, M and C have a_rows, b_rows, a_rows and a_rows entries and
+// outputs_count[2] is a_rows. Dense inputs are then compressed row by row and C is formed by the row-wise Gustavson
+// product, so row-major data is never read with a column stride.
+// Index arrays in task data are always 32-bit; internally the task switches to 64-bit indices when NeedsWideIndices
+// holds for the nnz of A and B and a bound on that of C.
+constexpr size_t kDenseInputs = 2;
+constexpr size_t kSparseInputs = 6;
+constexpr size_t kMaskInputs = 3;
+constexpr size_t kSparseOutputs = 3;
+
+// True when operands of a_nnz and b_nnz entries or a product of up to product_nnz entries need more than 32-bit
+// offsets. Row and column indices always fit, since the dimensions are int, so only the entry counts decide.
+inline bool NeedsWideIndices(std::uint64_t a_nnz, std::uint64_t b_nnz, std::uint64_t product_nnz) {
+  const auto limit = static_cast<std::uint64_t>(std::numeric_limits<int>::max());
+  return a_nnz > limit || b_nnz > limit || product_nnz > limit;
+}
+
+// Operands, result and cached plan of the task for one index width.
+template <typename Index, typename Policy>
+struct TaskOperands {
+  BasicSparseMatrix<double, Index, Policy> first;
+  BasicSparseMatrix<double, Index, Policy> second;
+  BasicSparseMatrix<double, Index, Policy> result;
+  // Set when the task data carries a mask; Run then takes MultiplyMasked instead of the plan.
+  std::optional<BasicSparseMatrix<double, Index, Policy>> mask;
+  BasicSpGEMMPlan<double, Index, Policy> plan;
+};
+
+// C = A * B as a ppc::core::Task whose kernels run under Policy. The backend tasks derive from it with their
+// policy filled in. In kCsr layout the operands are held as the CCS forms of B^T, A^T and M^T, which share the CSR
+// arrays of B, A and M, so the plan and kernels are the same and compute C^T, i.e. C in CSR.
+template <typename Policy>
+class CCSMatrixTask : public ppc::core::Task {
+  // PreProcessing switches alternatives only when the index width changes, so the plan survives repeated runs.
+  std::variant<TaskOperands<int, Policy>, TaskOperands<std::int64_t, Policy>> operands_;
+  MultiplyStats stats_;
+  SparseLayout layout_;
+  DropPolicy drop_;
+
+ public:
+  explicit CCSMatrixTask(ppc::core::TaskDataPtr task_data, SparseLayout layout = SparseLayout::kCcs)
+      : Task(std::move(task_data)), layout_(layout) {}
+
+  // C for a kCcs task, C^T for a kCsr one.
+  template <typename Index = int>
+  const BasicSparseMatrix<double, Index, Policy>& GetResult() const {
+    return std::get<TaskOperands<Index, Policy>>(operands_).result;
+  }
+  // C of a kCsr task, sharing the arrays of GetResult.
+  template <typename Index = int>
+  BasicCsrMatrix<double, Index, Policy> GetCsrResult() const {
+    return BasicCsrMatrix<double, Index, Policy>(GetResult<Index>());
+  }
+  // Work of the last Run. A masked Run fills in output_nnz only.
+  const MultiplyStats& GetStats() const { return stats_; }
+  // Entries of C the next Runs store; in kCsr layout top_k counts per row of C.
+  void SetDropPolicy(const DropPolicy& drop) { drop_ = drop; }
+
+  bool PreProcessingImpl() override;
+  bool ValidationImpl() override;
+  bool RunImpl() override;
+  bool PostProcessingImpl() override;
+};
+
+namespace detail {
+
+template <typename Index, typename Policy>
+BasicSparseMatrix<double, Index, Policy> ReadSparseInput(const ppc::core::TaskData& task_data, size_t first_input,
+                                                         int rows_count, int columns_count, size_t nnz) {
+  const auto* values = reinterpret_cast<const double*>(task_data.inputs[first_input]);
+  const auto* row_indices = reinterpret_cast<const int*>(task_data.inputs[first_input + 1]);
+  const auto* cumulative = reinterpret_cast<const int*>(task_data.inputs[first_input + 2]);
+  if constexpr (std::is_same_v<Index, int>) {
+    // The task data buffers outlive the task, so the input matrix is a view over them rather than a copy.
+    return BasicSparseMatrix<double, Index, Policy>(
+        rows_count, columns_count, std::span<const double>(values, nnz), std::span<const int>(row_indices, nnz),
+        std::span<const int>(cumulative, static_cast<size_t>(columns_count)));
+  } else {
+    // Wide products need their operands in the same index type, so the 32-bit arrays are widened into copies.
+    return BasicSparseMatrix<double, Index, Policy>(rows_count, columns_count,
+                                                    std::vector<double>(values, values + nnz),
+                                                    std::vector<Index>(row_indices, row_indices + nnz),
+                                                    std::vector<Index>(cumulative, cumulative + columns_count));
+  }
+}
+
+// Inputs that belong to A and B, i.e. all of them but a trailing mask.
+inline size_t OperandInputs(const ppc::core::TaskData& task_data) {
+  size_t inputs = task_data.inputs.size();
+  bool masked = inputs == kDenseInputs + kMaskInputs || inputs == kSparseInputs + kMaskInputs;
+  return masked ? inputs - kMaskInputs : inputs;
+}
+
+inline bool HasMask(const ppc::core::TaskData& task_data) {
+  return OperandInputs(task_data) != task_data.inputs.size();
+}
+
+// Products A * B takes, the sum over k of nnz(A(:, k)) * nnz(B(k, :)), for sparse A and B whose arrays start at
+// inputs first_input and second_input; it bounds the nnz of the product. The cumulative counts of A in CCS, or of
+// B in CSR, are already per k, so one pass over the indices of the other operand gives the rest.
+inline std::uint64_t ProductFlops(const ppc::core::TaskData& task_data, SparseLayout layout, size_t first_input,
+                                  size_t second_input, size_t inner, size_t first_nnz, size_t second_nnz) {
+  bool csr = layout == SparseLayout::kCsr;
+  const auto* sliced = reinterpret_cast<const int*>(task_data.inputs[(csr ? second_input : first_input) + 2]);
+  const auto* indices = reinterpret_cast<const int*>(task_data.inputs[(csr ? first_input : second_input) + 1]);
+  size_t indexed_nnz = csr ? first_nnz : second_nnz;
+  std::vector<std::uint64_t> hits(inner, 0);
+  for (size_t i = 0; i < indexed_nnz; i++) hits[indices[i]]++;
+  std::uint64_t flops = 0;
+  int previous = 0;
+  for (size_t k = 0; k < inner; k++) {
+    flops += static_cast<std::uint64_t>(sliced[k] - previous) * hits[k];
+    previous = sliced[k];
+  }
+  return flops;
+}
+
+// NeedsWideIndices for the operands of the task. Dense operands are as large as their shapes, so the shapes bound
+// everything; sparse ones are counted, and only products whose shape exceeds 32-bit offsets pay for ProductFlops.
+inline bool TaskNeedsWideIndices(const ppc::core::TaskData& task_data, SparseLayout layout) {
+  const auto& counts = task_data.inputs_count;
+  auto entries = [](std::uint64_t rows, std::uint64_t cols) { return rows * cols; };
+  std::uint64_t product_nnz = entries(counts[0], counts[3]);
+  if (OperandInputs(task_data) != kSparseInputs) {
+    return NeedsWideIndices(entries(counts[0], counts[1]), entries(counts[2], counts[3]), product_nnz);
+  }
+  if (HasMask(task_data) && NeedsWideIndices(counts.back(), 0, 0)) return true;
+  if (!NeedsWideIndices(counts[4], counts[5], product_nnz)) return false;
+  auto flops = ProductFlops(task_data, layout, 0, 3, counts[1], counts[4], counts[5]);
+  return NeedsWideIndices(counts[4], counts[5], std::min(product_nnz, flops));
+}
+
+// True when the rows_count x columns_count operand whose arrays start at input first_input holds nnz entries the
+// kernels can read: cumulative counts that never decrease and end at nnz, and in every column indices below the
+// row count in increasing order. kCsr arrays are checked the same way with rows in place of columns.
+inline bool IsValidSparseInput(const ppc::core::TaskData& task_data, SparseLayout layout, size_t first_input,
+                               size_t rows_count, size_t columns_count, size_t nnz) {
+  size_t slices = layout == SparseLayout::kCsr ? rows_count : columns_count;
+  size_t bound = layout == SparseLayout::kCsr ? columns_count : rows_count;
+  const auto* indices = reinterpret_cast<const int*>(task_data.inputs[first_input + 1]);
+  const auto* cumulative = reinterpret_cast<const int*>(task_data.inputs[first_input + 2]);
+  if ((nnz > 0 && (task_data.inputs[first_input] == nullptr || indices == nullptr)) ||
+      (slices > 0 && cumulative == nullptr)) {
+    return false;
+  }
+  size_t start = 0;
+  for (size_t slice = 0; slice < slices; slice++) {
+    if (cumulative[slice] < 0 || static_cast<size_t>(cumulative[slice]) < start ||
+        static_cast<size_t>(cumulative[slice]) > nnz) {
+      return false;
+    }
+    auto end = static_cast<size_t>(cumulative[slice]);
+    for (size_t i = start; i < end; i++) {
+      if (indices[i] < 0 || static_cast<size_t>(indices[i]) >= bound || (i > start && indices[i] <= indices[i - 1])) {
+        return false;
+      }
+    }
+    start = end;
+  }
+  return start == nnz;
+}
+
+template <typename Index, typename Policy>
+TaskOperands<Index, Policy>& SelectOperands(
+    std::variant<TaskOperands<int, Policy>, TaskOperands<std::int64_t, Policy>>& operands) {
+  if (!std::holds_alternative<TaskOperands<Index, Policy>>(operands)) {
+    operands.template emplace<TaskOperands<Index, Policy>>();
+  }
+  return std::get<TaskOperands<Index, Policy>>(operands);
+}
+
+// Operand of input first_input that is rows_count x columns_count, as CCS for kCcs and as the CCS form of its
+// transpose for kCsr.
+template <typename Index, typename Policy>
+BasicSparseMatrix<double, Index, Policy> ReadOperand(const ppc::core::TaskData& task_data, SparseLayout layout,
+                                                     size_t first_input, int rows_count, int columns_count,
+                                                     size_t nnz) {
+  if (layout == SparseLayout::kCsr) {
+    return ReadSparseInput<Index, Policy>(task_data, first_input, columns_count, rows_count, nnz);
+  }
+  return ReadSparseInput<Index, Policy>(task_data, first_input, rows_count, columns_count, nnz);
+}
+
+template <typename Index, typename Policy>
+BasicSparseMatrix<double, Index, Policy> CompressOperand(SparseLayout layout, int rows_count, int columns_count,
+                                                         const uint8_t* values) {
+  const auto* dense = reinterpret_cast<const double*>(values);
+  if (layout == SparseLayout::kCsr) {
+    return MatrixToCsr<double, Index, Policy>(rows_count, columns_count, dense).AsTransposed();
+  }
+  return MatrixToSparse<double, Index, Policy>(rows_count, columns_count, dense);
+}
+
+template <typename Index, typename Policy>
+void LoadOperands(const ppc::core::TaskData& task_data, SparseLayout layout, TaskOperands<Index, Policy>& operands) {
+  int f_rows = static_cast<int>(task_data.inputs_count[0]);
+  int f_cols = static_cast<int>(task_data.inputs_count[1]);
+  int s_rows = static_cast<int>(task_data.inputs_count[2]);
+  int s_cols = static_cast<int>(task_data.inputs_count[3]);
+
+  BasicSparseMatrix<double, Index, Policy> first;
+  BasicSparseMatrix<double, Index, Policy> second;
+  if (OperandInputs(task_data) == kSparseInputs) {
+    first = ReadOperand<Index, Policy>(task_data, layout, 0, f_rows, f_cols, task_data.inputs_count[4]);
+    second = ReadOperand<Index, Policy>(task_data, layout, 3, s_rows, s_cols, task_data.inputs_count[5]);
+  } else {
+    first = CompressOperand<Index, Policy>(layout, f_rows, f_cols, task_data.inputs[0]);
+    second = CompressOperand<Index, Policy>(layout, s_rows, s_cols, task_data.inputs[1]);
+  }
+  // C^T = B^T * A^T, so a kCsr task hands the transposes to the kernels in swapped order.
+  if (layout == SparseLayout::kCsr) std::swap(first, second);
+  operands.first = std::move(first);
+  operands.second = std::move(second);
+  if (HasMask(task_data)) {
+    operands.mask = ReadOperand<Index, Policy>(task_data, layout, task_data.inputs.size() - kMaskInputs, f_rows,
+                                               s_cols, task_data.inputs_count.back());
+  } else {
+    operands.mask.reset();
+  }
+}
+
+// Writes C, or C^T for kCsr, whose CCS arrays are then the CSR arrays of C.
+template <typename Index, typename Policy>
+bool WriteResult(ppc::core::TaskData& task_data, SparseLayout layout,
+                 const BasicSparseMatrix<double, Index, Policy>& result) {
+  if (task_data.outputs.size() == kSparseOutputs) {
+    auto values = result.GetValues();
+    auto row_indices = result.GetRowIndices();
+    auto cumulative = result.GetCumulativeElements();
+    if (values.size() > task_data.outputs_count[0] || row_indices.size() > task_data.outputs_count[1]) return false;
+    // The output layout carries 32-bit offsets.
+    if (values.size() > static_cast<size_t>(std::numeric_limits<int>::max())) return false;
+    std::copy(values.begin(), values.end(), reinterpret_cast<double*>(task_data.outputs[0]));
+    std::transform(row_indices.begin(), row_indices.end(), reinterpret_cast<int*>(task_data.outputs[1]),
+                   [](Index row) { return static_cast<int>(row); });
+    std::transform(cumulative.begin(), cumulative.end(), reinterpret_cast<int*>(task_data.outputs[2]),
+                   [](Index count) { return static_cast<int>(count); });
+    task_data.outputs_count[0] = static_cast<std::uint32_t>(values.size());
+    task_data.outputs_count[1] = static_cast<std::uint32_t>(row_indices.size());
+    return true;
+  }
+  auto dense = layout == SparseLayout::kCsr ? FromCsrMatrix(BasicCsrMatrix<double, Index, Policy>(result))
+                                            : FromSparseMatrix(result);
+  std::copy(dense.begin(), dense.end(), reinterpret_cast<double*>(task_data.outputs[0]));
+  return true;
+}
+
+}  // namespace detail
+
+template <typename Policy>
+bool CCSMatrixTask<Policy>::PreProcessingImpl() {
+  int f_rows = static_cast<int>(task_data->inputs_count[0]);
+  int f_cols = static_cast<int>(task_data->inputs_count[1]);
+  int s_rows = static_cast<int>(task_data->inputs_count[2]);
+  int s_cols = static_cast<int>(task_data->inputs_count[3]);
+
+  if (f_rows == 0 || f_cols == 0 || s_rows == 0 || s_cols == 0) return true;
+
+  if (detail::TaskNeedsWideIndices(*task_data, layout_)) {
+    detail::LoadOperands(*task_data, layout_, detail::SelectOperands<std::int64_t, Policy>(operands_));
+  } else {
+    detail::LoadOperands(*task_data, layout_, detail::SelectOperands<int, Policy>(operands_));
+  }
+  return true;
+}
+
+template <typename Policy>
+bool CCSMatrixTask<Policy>::ValidationImpl() {
+  const auto& counts = task_data->inputs_count;
+  // A mask adds its nnz as the one count after the operands' own.
+  size_t mask_counts = detail::HasMask(*task_data) ? 1 : 0;
+  if (detail::OperandInputs(*task_data) == kSparseInputs) {
+    if (counts.size() != kSparseInputs + mask_counts) return false;
+  } else if (detail::OperandInputs(*task_data) != kDenseInputs || counts.size() < 4 ||
+             (mask_counts != 0 && counts.size() != 4 + mask_counts)) {
+    return false;
+  }
+  // A sparse C has a cumulative count per column, or per row for kCsr.
+  auto result_slices = layout_ == SparseLayout::kCsr ? counts[0] : counts[3];
+  if (task_data->outputs.size() == kSparseOutputs &&
+      (task_data->outputs_count.size() != kSparseOutputs || task_data->outputs_count[2] != result_slices)) {
+    return false;
+  }
+  if (counts[0] != counts[3] || counts[1] != counts[2]) return false;
+  // Sparse arrays are read as they are, so counts that do not match them would send Run out of bounds.
+  if (detail::OperandInputs(*task_data) == kSparseInputs &&
+      (!detail::IsValidSparseInput(*task_data, layout_, 0, counts[0], counts[1], counts[4]) ||
+       !detail::IsValidSparseInput(*task_data, layout_, 3, counts[2], counts[3], counts[5]))) {
+    return false;
+  }
+  return mask_counts == 0 || detail::IsValidSparseInput(*task_data, layout_, task_data->inputs.size() - kMaskInputs,
+                                                        counts[0], counts[3], counts.back());
+}
+
+template <typename Policy>
+bool CCSMatrixTask<Policy>::RunImpl() {
+  std::visit(
+      [this](auto& operands) {
+        if (operands.mask) {
+          operands.result = operands.first.MultiplyMasked(operands.second, *operands.mask, drop_);
+          stats_ = MultiplyStats{};
+          stats_.output_nnz = operands.result.GetValues().size();
+          return;
+        }
+        if (!operands.plan.Matches(operands.first, operands.second)) {
+          operands.plan = decltype(operands.plan)(operands.first, operands.second);
+        }
+        operands.result = operands.plan.Multiply(operands.first, operands.second, &stats_, drop_);
+      },
+      operands_);
+  return true;
+}
+
+template <typename Policy>
+bool CCSMatrixTask<Policy>::PostProcessingImpl() {
+  return std::visit([&](const auto& operands) { return detail::WriteResult(*task_data, layout_, operands.result); },
+                    operands_);
+}
+
+}  // namespace ppc::sparse
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+#include "sparse/matrix/include/csr_matrix.hpp"
+#include "sparse/matrix/include/sparse_chain.hpp"
+#include "sparse/matrix/include/sparse_matrix.hpp"
+#include "sparse/task/include/ccs_matrix_task.hpp"
+
+namespace ppc::sparse {
+
+// TaskData layouts accepted by ChainProductTask, for n >= 2 operands M_0 ... M_{n-1}:
+//   dense input:  inputs = {M_0, ..., M_{n-1}} as row-major doubles, inputs_count = {rows_0, cols_0, ...,
+//                 rows_{n-1}, cols_{n-1}};
+//   sparse input: inputs = {values, row indices, cumulative counts} of every operand in SparseMatrix form,
+//                 inputs_count = the dimensions as above followed by nnz_0, ..., nnz_{n-1};
+//   outputs:      as for CCSMatrixTask, with the product rows_0 x cols_{n-1}.
+// A kCsr task reads and writes the sparse arrays in CSR form, as CCSMatrixTask does.
+
+// Operands, result and cached chain plan of the task for one index width.
+template <typename Index, typename Policy>
+struct ChainOperands {
+  std::vector<BasicSparseMatrix<double, Index, Policy>> operands;
+  BasicSparseMatrix<double, Index, Policy> result;
+  BasicChainPlan<double, Index, Policy> plan;
+};
+
+// M_0 * ... * M_{n-1} as one ppc::core::Task whose kernels run under Policy, e.g. the Galerkin product R^T * A * P
+// of a multigrid setup. The intermediates stay in CCS form inside the chain plan, which picks the association order
+// and survives repeated runs, instead of each pairwise product being converted in and out of task data.
+template <typename Policy>
+class ChainProductTask : public ppc::core::Task {
+  std::variant<ChainOperands<int, Policy>, ChainOperands<std::int64_t, Policy>> operands_;
+  MultiplyStats stats_;
+  SparseLayout layout_;
+  DropPolicy drop_;
+
+ public:
+  explicit ChainProductTask(ppc::core::TaskDataPtr task_data, SparseLayout layout = SparseLayout::kCcs)
+      : Task(std::move(task_data)), layout_(layout) {}
+
+  // The product for a kCcs task, its transpose for a kCsr one.
+  template <typename Index = int>
+  const BasicSparseMatrix<double, Index, Policy>& GetResult() const {
+    return std::get<ChainOperands<Index, Policy>>(operands_).result;
+  }
+  // The order of the last Run, over the operands as the kernels see them: reversed and transposed for kCsr.
+  template <typename Index = int>
+  const BasicChainPlan<double, Index, Policy>& GetPlan() const {
+    return std::get<ChainOperands<Index, Policy>>(operands_).plan;
+  }
+  // Work of all products of the last Run.
+  const MultiplyStats& GetStats() const { return stats_; }
+  // Entries the next Runs keep of every product, intermediates included.
+  void SetDropPolicy(const DropPolicy& drop) { drop_ = drop; }
+
+  bool PreProcessingImpl() override;
+  bool ValidationImpl() override;
+  bool RunImpl() override;
+  bool PostProcessingImpl() override;
+};
+
+namespace detail {
+
+// Three arrays and three counts per sparse operand against one array and two counts per dense one.
+inline bool HasSparseChain(const ppc::core::TaskData& task_data) {
+  return task_data.inputs.size() == task_data.inputs_count.size();
+}
+
+inline size_t ChainLength(const ppc::core::TaskData& task_data) {
+  return HasSparseChain(task_data) ? task_data.inputs.size() / 3 : task_data.inputs.size();
+}
+
+// True when an operand or any product of consecutive operands could hold more entries than 32-bit offsets address.
+// M_i * ... * M_j has at most rows_i * cols_j, nnz_i * cols_j and rows_i * nnz_j entries, and a product of two
+// sparse operands at most ProductFlops of them, which is only counted when the other bounds do not suffice.
+inline bool ChainNeedsWideIndices(const ppc::core::TaskData& task_data, SparseLayout layout) {
+  const auto& counts = task_data.inputs_count;
+  size_t length = ChainLength(task_data);
+  bool sparse = HasSparseChain(task_data);
+  auto rows = [&](size_t i) { return static_cast<std::uint64_t>(counts[2 * i]); };
+  auto cols = [&](size_t i) { return static_cast<std::uint64_t>(counts[(2 * i) + 1]); };
+  auto nnz = [&](size_t i) {
+    return sparse ? static_cast<std::uint64_t>(counts[(2 * length) + i]) : rows(i) * cols(i);
+  };
+  for (size_t first = 0; first < length; first++) {
+    if (NeedsWideIndices(nnz(first), 0, 0)) return true;
+    for (size_t last = first + 1; last < length; last++) {
+      auto bound = std::min({rows(first) * cols(last), nnz(first) * cols(last), rows(first) * nnz(last)});
+      if (sparse && last == first + 1 && NeedsWideIndices(0, 0, bound)) {
+        bound = std::min(bound, ProductFlops(task_data, layout, 3 * first, 3 * last, cols(first), nnz(first),
+                                             nnz(last)));
+      }
+      if (NeedsWideIndices(0, 0, bound)) return true;
+    }
+  }
+  return false;
+}
+
+template <typename Index, typename Policy>
+ChainOperands<Index, Policy>& SelectChain(
+    std::variant<ChainOperands<int, Policy>, ChainOperands<std::int64_t, Policy>>& operands) {
+  if (!std::holds_alternative<ChainOperands<Index, Policy>>(operands)) {
+    operands.template emplace<ChainOperands<Index, Policy>>();
+  }
+  return std::get<ChainOperands<Index, Policy>>(operands);
+}
+
+template <typename Index, typename Policy>
+void LoadChain(const ppc::core::TaskData& task_data, SparseLayout layout, ChainOperands<Index, Policy>& chain) {
+  size_t length = ChainLength(task_data);
+  chain.operands.clear();
+  for (size_t i = 0; i < length; i++) {
+    int rows = static_cast<int>(task_data.inputs_count[2 * i]);
+    int cols = static_cast<int>(task_data.inputs_count[(2 * i) + 1]);
+    if (HasSparseChain(task_data)) {
+      chain.operands.push_back(
+          ReadOperand<Index, Policy>(task_data, layout, 3 * i, rows, cols, task_data.inputs_count[(2 * length) + i]));
+    } else {
+      chain.operands.push_back(CompressOperand<Index, Policy>(layout, rows, cols, task_data.inputs[i]));
+    }
+  }
+  // (M_0 * ... * M_{n-1})^T = M_{n-1}^T * ... * M_0^T.
+  if (layout == SparseLayout::kCsr) std::ranges::reverse(chain.operands);
+}
+
+}  // namespace detail
+
+template <typename Policy>
+bool ChainProductTask<Policy>::PreProcessingImpl() {
+  if (detail::ChainNeedsWideIndices(*task_data, layout_)) {
+    detail::LoadChain(*task_data, layout_, detail::SelectChain<std::int64_t, Policy>(operands_));
+  } else {
+    detail::LoadChain(*task_data, layout_, detail::SelectChain<int, Policy>(operands_));
+  }
+  return true;
+}
+
+template <typename Policy>
+bool ChainProductTask<Policy>::ValidationImpl() {
+  const auto& counts = task_data->inputs_count;
+  size_t length = detail::ChainLength(*task_data);
+  bool sparse = detail::HasSparseChain(*task_data);
+  if (length < 2 || (sparse ? task_data->inputs.size() != 3 * length : counts.size() != 2 * length)) return false;
+  for (size_t i = 1; i < length; i++) {
+    if (counts[(2 * i) - 1] != counts[2 * i]) return false;
+  }
+  for (size_t i = 0; sparse && i < length; i++) {
+    if (!detail::IsValidSparseInput(*task_data, layout_, 3 * i, counts[2 * i], counts[(2 * i) + 1],
+                                    counts[(2 * length) + i])) {
+      return false;
+    }
+  }
+  if (task_data->outputs.size() == kSparseOutputs) {
+    auto result_slices = layout_ == SparseLayout::kCsr ? counts[0] : counts[(2 * length) - 1];
+    return task_data->outputs_count.size() == kSparseOutputs && task_data->outputs_count[2] == result_slices;
+  }
+  return task_data->outputs.size() == 1;
+}
+
+template <typename Policy>
+bool ChainProductTask<Policy>::RunImpl() {
+  std::visit(
+      [this](auto& chain) {
+        if (!chain.plan.Fits(chain.operands)) chain.plan = decltype(chain.plan)(chain.operands);
+        chain.result = chain.plan.Multiply(chain.operands, &stats_, drop_);
+      },
+      operands_);
+  return true;
+}
+
+template <typename Policy>
+bool ChainProductTask<Policy>::PostProcessingImpl() {
+  return std::visit([&](const auto& chain) { return detail::WriteResult(*task_data, layout_, chain.result); },
+                    operands_);
+}
+
+}  // namespace ppc::sparse
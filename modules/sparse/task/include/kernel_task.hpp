@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "core/perf/include/perf.hpp"
+#include "core/task/include/task.hpp"
+
+namespace ppc::sparse {
+
+// A library call as a ppc::core::Task, so that the perf tests time kernels that have no task of their own (plans,
+// transposes, generators, file formats) through ppc::core::Perf like the tasks. The caller prepares the operands
+// and keeps whatever the kernel produces; Run calls the kernel and the other stages have nothing to do.
+class KernelTask : public ppc::core::Task {
+  std::function<void()> kernel_;
+
+ public:
+  explicit KernelTask(std::function<void()> kernel)
+      : Task(std::make_shared<ppc::core::TaskData>()), kernel_(std::move(kernel)) {}
+
+  bool ValidationImpl() override { return true; }
+  bool PreProcessingImpl() override { return true; }
+  bool RunImpl() override {
+    kernel_();
+    return true;
+  }
+  bool PostProcessingImpl() override { return true; }
+};
+
+// Times num_running calls of task's Run with ppc::core::Perf::TaskRun, or of its whole pipeline with PipelineRun
+// for kPipeline, and prints the statistic for the automation checkers.
+inline void MeasurePerf(const std::shared_ptr<ppc::core::Task>& task, uint64_t num_running,
+                        ppc::core::PerfResults::TypeOfRunning type = ppc::core::PerfResults::kTaskRun) {
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = num_running;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perf_attr->current_timer = [&] {
+    auto current_time_point = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+    return static_cast<double>(duration) * 1e-9;
+  };
+
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf perf_analyzer(task);
+  if (type == ppc::core::PerfResults::kPipeline) {
+    perf_analyzer.PipelineRun(perf_attr, perf_results);
+  } else {
+    perf_analyzer.TaskRun(perf_attr, perf_results);
+  }
+  ppc::core::Perf::PrintPerfStatistic(perf_results);
+}
+
+// MeasurePerf of a KernelTask running kernel.
+inline void MeasureKernel(std::function<void()> kernel, uint64_t num_running) {
+  MeasurePerf(std::make_shared<KernelTask>(std::move(kernel)), num_running);
+}
+
+}  // namespace ppc::sparse
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+#include "sparse/matrix/include/csr_matrix.hpp"
+#include "sparse/matrix/include/sparse_matrix.hpp"
+#include "sparse/matrix/include/spmv.hpp"
+#include "sparse/task/include/ccs_matrix_task.hpp"
+
+namespace ppc::sparse {
+
+// Y = A * X as a ppc::core::Task whose kernels run under Policy.
+//
+// TaskData layout: inputs = {A values, A row indices, A cumulative counts, X}, with A in SparseMatrix form and X as
+// a_cols x vectors row-major doubles; inputs_count = {a_rows, a_cols, a_nnz, vectors}; outputs = {Y} with room for
+// a_rows x vectors doubles. A kCsr task converts A in PreProcessing, so Run times the multiply alone.
+template <typename Policy>
+class SpMMTask : public ppc::core::Task {
+  using Matrix = BasicSparseMatrix<double, int, Policy>;
+
+  SparseLayout layout_;
+  // A for kCcs, A^T for kCsr.
+  Matrix matrix_;
+  const double* block_ = nullptr;
+  int vectors_ = 0;
+  std::vector<double> result_;
+
+ public:
+  explicit SpMMTask(ppc::core::TaskDataPtr task_data, SparseLayout layout = SparseLayout::kCsr)
+      : Task(std::move(task_data)), layout_(layout) {}
+
+  bool PreProcessingImpl() override;
+  bool ValidationImpl() override;
+  bool RunImpl() override;
+  bool PostProcessingImpl() override;
+};
+
+template <typename Policy>
+bool SpMMTask<Policy>::PreProcessingImpl() {
+  int rows = static_cast<int>(task_data->inputs_count[0]);
+  int cols = static_cast<int>(task_data->inputs_count[1]);
+  size_t nnz = task_data->inputs_count[2];
+  vectors_ = static_cast<int>(task_data->inputs_count[3]);
+  // The task data buffers outlive the task, so A is a view over them rather than a copy.
+  Matrix matrix(rows, cols, std::span<const double>(reinterpret_cast<const double*>(task_data->inputs[0]), nnz),
+                std::span<const int>(reinterpret_cast<const int*>(task_data->inputs[1]), nnz),
+                std::span<const int>(reinterpret_cast<const int*>(task_data->inputs[2]), static_cast<size_t>(cols)));
+  matrix_ = layout_ == SparseLayout::kCsr ? Matrix::ComputeTranspose(matrix) : std::move(matrix);
+  block_ = reinterpret_cast<const double*>(task_data->inputs[3]);
+  result_.assign(static_cast<size_t>(rows) * vectors_, 0);
+  return true;
+}
+
+template <typename Policy>
+bool SpMMTask<Policy>::ValidationImpl() {
+  const auto& counts = task_data->inputs_count;
+  if (task_data->inputs.size() != 4 || counts.size() != 4 || task_data->outputs.size() != 1 ||
+      task_data->outputs_count.size() != 1 || counts[0] == 0 || counts[1] == 0 || counts[3] == 0 ||
+      task_data->outputs_count[0] != static_cast<size_t>(counts[0]) * counts[3]) {
+    return false;
+  }
+  // A comes in CCS form whatever the task layout; PreProcessing views its arrays as they are.
+  return detail::IsValidSparseInput(*task_data, SparseLayout::kCcs, 0, counts[0], counts[1], counts[2]);
+}
+
+template <typename Policy>
+bool SpMMTask<Policy>::RunImpl() {
+  if (layout_ == SparseLayout::kCsr) {
+    MultiplyCsr(matrix_, block_, vectors_, result_.data());
+  } else {
+    MultiplyCcs(matrix_, block_, vectors_, result_.data());
+  }
+  return true;
+}
+
+template <typename Policy>
+bool SpMMTask<Policy>::PostProcessingImpl() {
+  std::ranges::copy(result_, reinterpret_cast<double*>(task_data->outputs[0]));
+  return true;
+}
+
+}  // namespace ppc::sparse
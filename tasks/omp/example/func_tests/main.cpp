@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/util/include/dense_gemm.hpp"
 #include "core/util/include/util.hpp"
 #include "omp/example/include/ops_omp.hpp"
 
@@ -71,3 +72,30 @@ TEST(nesterov_a_test_task_omp, test_matmul_100_from_file) {
   test_task_omp.PostProcessing();
   EXPECT_EQ(in, out);
 }
+
+TEST(nesterov_a_test_task_omp, test_matmul_70_matches_reference) {
+  constexpr int kCount = 70;
+
+  // Create data
+  std::vector<int> in(kCount * kCount, 0);
+  std::vector<int> out(kCount * kCount, 0);
+
+  for (size_t i = 0; i < in.size(); i++) {
+    in[i] = static_cast<int>(((i * 7) + 3) % 11) - 5;
+  }
+
+  // Create task_data
+  auto task_data_omp = std::make_shared<ppc::core::TaskData>();
+  task_data_omp->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data_omp->inputs_count.emplace_back(in.size());
+  task_data_omp->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data_omp->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  nesterov_a_test_task_omp::TestTaskOpenMP test_task_omp(task_data_omp);
+  ASSERT_EQ(test_task_omp.Validation(), true);
+  test_task_omp.PreProcessing();
+  test_task_omp.Run();
+  test_task_omp.PostProcessing();
+  EXPECT_EQ(out, ppc::util::MultiplyDense(in, in, kCount, kCount, kCount));
+}
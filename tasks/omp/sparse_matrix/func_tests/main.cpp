@@ -1,5 +1,18 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
 #include "core/task/include/task.hpp"
 #include "core/util/include/util.hpp"
 #include "omp/sparse_matrix/include/sparse_matrix_omp.hpp"
@@ -148,6 +161,1185 @@ TEST(sparse_matrix_multiplication_omp, test_random_large_matrices_multiplication
     EXPECT_NEAR(result[i], expectedOutput[i], epsilon) << "Mismatch at index " << i;
 }
 
+TEST(sparse_matrix_multiplication_omp, test_empty_rows_and_columns) {
+  const auto epsilon = 1e-6;
+
+  std::vector<double> matrixA{0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 3};
+  std::vector<double> matrixB{0, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5, 0, 6, 0, 0};
+  std::vector<double> result(16, 0);
+
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.push_back(reinterpret_cast<uint8_t*>(matrixA.data()));
+  taskData->inputs.push_back(reinterpret_cast<uint8_t*>(matrixB.data()));
+  taskData->inputs_count = {4, 4, 4, 4};
+  taskData->outputs.push_back(reinterpret_cast<uint8_t*>(result.data()));
+  taskData->outputs_count.push_back(result.size());
+
+  auto expectedOutput = sparse_matrix_multiplication_omp::MultiplyMatrices(matrixA, 4, 4, matrixB, 4, 4);
+
+  sparse_matrix_multiplication_omp::CCSMatrixOMP multiplicationTask(taskData);
+  ASSERT_TRUE(multiplicationTask.Validation()) << "Validation failed!";
+
+  multiplicationTask.PreProcessing();
+  multiplicationTask.Run();
+  multiplicationTask.PostProcessing();
+
+  for (size_t i = 0; i < result.size(); i++)
+    EXPECT_NEAR(result[i], expectedOutput[i], epsilon) << "Mismatch at index " << i;
+}
+
+TEST(sparse_matrix_multiplication_omp, test_cancelled_entries_are_dropped) {
+  const auto epsilon = 1e-6;
+
+  std::vector<double> matrixA{1, 1, 2, 0};
+  std::vector<double> matrixB{1, 3, -1, 0};
+
+  std::vector<double> expectedOutput{0, 3, 2, 6};
+
+  std::vector<double> result(4, 0);
+
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.push_back(reinterpret_cast<uint8_t*>(matrixA.data()));
+  taskData->inputs.push_back(reinterpret_cast<uint8_t*>(matrixB.data()));
+  taskData->inputs_count = {2, 2, 2, 2};
+  taskData->outputs.push_back(reinterpret_cast<uint8_t*>(result.data()));
+  taskData->outputs_count.push_back(result.size());
+
+  sparse_matrix_multiplication_omp::CCSMatrixOMP multiplicationTask(taskData);
+  ASSERT_TRUE(multiplicationTask.Validation()) << "Validation failed!";
+
+  multiplicationTask.PreProcessing();
+  multiplicationTask.Run();
+  multiplicationTask.PostProcessing();
+
+  for (size_t i = 0; i < result.size(); i++)
+    EXPECT_NEAR(result[i], expectedOutput[i], epsilon) << "Mismatch at index " << i;
+}
+
+TEST(sparse_matrix_multiplication_omp, test_drop_policy) {
+  // Every other entry of A negated makes C mixed in sign; the products are integers, so C is exact and ties in
+  // magnitude within a column are common.
+  auto matrixA = sparse_matrix_multiplication_omp::GenerateRandomMatrix(30 * 40);
+  for (size_t i = 0; i < matrixA.size(); i += 2) matrixA[i] = -matrixA[i];
+  auto matrixB = sparse_matrix_multiplication_omp::GenerateRandomMatrix(40 * 25);
+  auto expected = sparse_matrix_multiplication_omp::MultiplyMatrices(matrixA, 30, 40, matrixB, 40, 25);
+  auto first = sparse_matrix_multiplication_omp::MatrixToSparse(30, 40, matrixA);
+  auto second = sparse_matrix_multiplication_omp::MatrixToSparse(40, 25, matrixB);
+
+  // The default policy keeps negative entries.
+  EXPECT_EQ(sparse_matrix_multiplication_omp::FromSparseMatrix(first * second), expected);
+
+  const sparse_matrix_multiplication_omp::DropPolicy drop{.absolute = 5e4, .relative = 0.25, .top_k = 4};
+  auto pruned = sparse_matrix_multiplication_omp::FromSparseMatrix(first.Multiply(second, drop));
+  for (int col = 0; col < 25; col++) {
+    auto magnitude = [&](int row) { return std::abs(expected[(row * 25) + col]); };
+    double largest = 0;
+    for (int row = 0; row < 30; row++) largest = std::max(largest, magnitude(row));
+    std::vector<int> survivors;
+    for (int row = 0; row < 30; row++) {
+      if (magnitude(row) > drop.absolute && magnitude(row) >= drop.relative * largest) survivors.push_back(row);
+    }
+    std::ranges::stable_sort(survivors, std::greater<>(), magnitude);
+    if (survivors.size() > 4) survivors.resize(4);
+    for (int row = 0; row < 30; row++) {
+      auto kept = std::ranges::find(survivors, row) != survivors.end();
+      EXPECT_EQ(pruned[(row * 25) + col], kept ? expected[(row * 25) + col] : 0) << "at " << row << ", " << col;
+    }
+  }
+
+  // The plan and the other product kernels prune alike.
+  sparse_matrix_multiplication_omp::SpGEMMPlan plan(first, second);
+  EXPECT_EQ(sparse_matrix_multiplication_omp::FromSparseMatrix(plan.Multiply(first, second, nullptr, drop)), pruned);
+  EXPECT_EQ(sparse_matrix_multiplication_omp::FromSparseMatrix(first.MultiplyInner(second, drop)), pruned);
+  auto mask = sparse_matrix_multiplication_omp::MatrixToSparse(30, 25, std::vector<double>(30 * 25, 1));
+  EXPECT_EQ(sparse_matrix_multiplication_omp::FromSparseMatrix(first.MultiplyMasked(second, mask, drop)), pruned);
+}
+
+TEST(sparse_matrix_multiplication_omp, test_plan_reuse) {
+  // A plan serves any operands with the patterns it was built for: 2 * A on A's pattern gives 2 * (A * B).
+  auto matrixA = sparse_matrix_multiplication_omp::GenerateRandomMatrix(30 * 40);
+  auto matrixB = sparse_matrix_multiplication_omp::GenerateRandomMatrix(40 * 25);
+  auto first = sparse_matrix_multiplication_omp::MatrixToSparse(30, 40, matrixA);
+  auto second = sparse_matrix_multiplication_omp::MatrixToSparse(40, 25, matrixB);
+  std::vector<double> scaled_values(first.GetValues().begin(), first.GetValues().end());
+  for (auto& value : scaled_values) value *= 2;
+  sparse_matrix_multiplication_omp::SparseMatrix scaled(30, 40, scaled_values, first.GetRowIndices(),
+                                                      first.GetCumulativeElements());
+
+  sparse_matrix_multiplication_omp::SpGEMMPlan plan(first, second);
+  auto expected = sparse_matrix_multiplication_omp::MultiplyMatrices(matrixA, 30, 40, matrixB, 40, 25);
+  EXPECT_EQ(sparse_matrix_multiplication_omp::FromSparseMatrix(plan.Multiply(first, second)), expected);
+  ASSERT_TRUE(plan.Matches(scaled, second));
+  for (auto& value : expected) value *= 2;
+  EXPECT_EQ(sparse_matrix_multiplication_omp::FromSparseMatrix(plan.Multiply(scaled, second)), expected);
+
+  auto empty = sparse_matrix_multiplication_omp::MatrixToSparse(30, 40, std::vector<double>(30 * 40, 0));
+  EXPECT_FALSE(plan.Matches(empty, second));
+}
+
+TEST(sparse_matrix_multiplication_omp, test_multiply_stats) {
+  // C(:, 0) takes three products onto two rows, one of which cancels; C(:, 1) takes two products onto two rows.
+  std::vector<double> matrixA{1, 1, 2, 0};
+  std::vector<double> matrixB{1, 3, -1, 0};
+  auto first = sparse_matrix_multiplication_omp::MatrixToSparse(2, 2, matrixA);
+  auto second = sparse_matrix_multiplication_omp::MatrixToSparse(2, 2, matrixB);
+
+  sparse_matrix_multiplication_omp::MultiplyStats stats;
+  first.Multiply(second, &stats);
+  EXPECT_EQ(stats.flops, 5U);
+  EXPECT_EQ(stats.accumulator_hits, 1U);
+  EXPECT_EQ(stats.output_nnz, 3U);
+
+  sparse_matrix_multiplication_omp::MultiplyStats plan_stats;
+  sparse_matrix_multiplication_omp::SpGEMMPlan(first, second).Multiply(first, second, &plan_stats);
+  EXPECT_EQ(plan_stats.flops, stats.flops);
+  EXPECT_EQ(plan_stats.accumulator_hits, stats.accumulator_hits);
+  EXPECT_EQ(plan_stats.output_nnz, stats.output_nnz);
+
+  std::vector<double> result(4, 0);
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.push_back(reinterpret_cast<uint8_t*>(matrixA.data()));
+  taskData->inputs.push_back(reinterpret_cast<uint8_t*>(matrixB.data()));
+  taskData->inputs_count = {2, 2, 2, 2};
+  taskData->outputs.push_back(reinterpret_cast<uint8_t*>(result.data()));
+  taskData->outputs_count.push_back(result.size());
+
+  // Stats describe the last run only; they do not pile up across runs.
+  sparse_matrix_multiplication_omp::CCSMatrixOMP multiplicationTask(taskData);
+  for (int run = 0; run < 2; run++) {
+    ASSERT_TRUE(multiplicationTask.Validation());
+    multiplicationTask.PreProcessing();
+    multiplicationTask.Run();
+    multiplicationTask.PostProcessing();
+    EXPECT_EQ(multiplicationTask.GetStats().flops, 5U);
+    EXPECT_EQ(multiplicationTask.GetStats().output_nnz, 3U);
+  }
+}
+
+TEST(sparse_matrix_multiplication_omp, test_hash_accumulator_columns) {
+  const int rows = 20000;
+  const int inner = 40;
+  const int cols = 10;
+
+  // A holds three scattered entries per column plus a dense column 0. Only the output columns that pick up A(:, 0)
+  // have enough products for the dense accumulator; all others go through the hash table.
+  std::vector<double> matrixA(static_cast<size_t>(rows) * inner, 0);
+  for (int row = 0; row < rows; row++) matrixA[static_cast<size_t>(row) * inner] = 1;
+  for (int k = 1; k < inner; k++) {
+    for (int j = 0; j < 3; j++) matrixA[(static_cast<size_t>((k * 7919) + (j * 4999)) % rows * inner) + k] = j + 1;
+  }
+  std::vector<double> matrixB(inner * cols, 0);
+  for (int k = 1; k < inner; k++) {
+    for (int c = 0; c < cols; c++) {
+      if ((k + c) % 7 == 0) matrixB[(k * cols) + c] = k;
+    }
+  }
+  matrixB[cols - 1] = 2;
+
+  auto first = sparse_matrix_multiplication_omp::MatrixToSparse(rows, inner, matrixA);
+  auto second = sparse_matrix_multiplication_omp::MatrixToSparse(inner, cols, matrixB);
+  auto expected = sparse_matrix_multiplication_omp::MultiplyMatrices(matrixA, rows, inner, matrixB, inner, cols);
+
+  sparse_matrix_multiplication_omp::MultiplyStats stats;
+  auto result = first.Multiply(second, &stats);
+  EXPECT_EQ(sparse_matrix_multiplication_omp::FromSparseMatrix(result), expected);
+  EXPECT_EQ(stats.output_nnz, static_cast<size_t>(std::ranges::count_if(expected, [](double v) { return v != 0; })));
+
+  auto planned = sparse_matrix_multiplication_omp::SpGEMMPlan(first, second).Multiply(first, second);
+  EXPECT_TRUE(std::ranges::equal(planned.GetRowIndices(), result.GetRowIndices()));
+  EXPECT_TRUE(std::ranges::equal(planned.GetValues(), result.GetValues()));
+}
+
+TEST(sparse_matrix_multiplication_omp, test_sparse_dot_matches_merge) {
+  // Lengths around the 8- and 16-lane blocks cover full SIMD blocks, their scalar tails and lists that never meet.
+  std::mt19937 generator(15);
+  std::vector<int> universe(200);
+  std::iota(universe.begin(), universe.end(), 0);
+  for (int first_length : {0, 1, 7, 8, 9, 16, 17, 40, 100}) {
+    for (int second_length : {0, 3, 8, 15, 16, 33, 100}) {
+      std::ranges::shuffle(universe, generator);
+      std::vector<int> first_indices(universe.begin(), universe.begin() + first_length);
+      std::ranges::shuffle(universe, generator);
+      std::vector<int> second_indices(universe.begin(), universe.begin() + second_length);
+      std::ranges::sort(first_indices);
+      std::ranges::sort(second_indices);
+      std::vector<double> first_values(first_length);
+      std::vector<double> second_values(second_length);
+      for (auto& value : first_values) value = static_cast<double>(generator() % 9) + 1;
+      for (auto& value : second_values) value = static_cast<double>(generator() % 9) + 1;
+
+      double expected = 0;
+      for (int p = 0; p < first_length; p++) {
+        for (int q = 0; q < second_length; q++) {
+          if (first_indices[p] == second_indices[q]) expected += first_values[p] * second_values[q];
+        }
+      }
+
+      EXPECT_EQ(sparse_matrix_multiplication_omp::SparseDot<double>(
+                    std::span<const int>(first_indices), std::span<const double>(first_values),
+                    std::span<const int>(second_indices), std::span<const double>(second_values)),
+                expected)
+          << first_length << " x " << second_length;
+
+      std::vector<std::int64_t> first_wide(first_indices.begin(), first_indices.end());
+      std::vector<std::int64_t> second_wide(second_indices.begin(), second_indices.end());
+      std::vector<float> first_floats(first_values.begin(), first_values.end());
+      std::vector<float> second_floats(second_values.begin(), second_values.end());
+      EXPECT_EQ(sparse_matrix_multiplication_omp::SparseDot<float>(
+                    std::span<const std::int64_t>(first_wide), std::span<const float>(first_floats),
+                    std::span<const std::int64_t>(second_wide), std::span<const float>(second_floats)),
+                static_cast<float>(expected))
+          << first_length << " x " << second_length;
+    }
+  }
+}
+
+TEST(sparse_matrix_multiplication_omp, test_multiply_inner_matches_gustavson) {
+  auto matrixA = sparse_matrix_multiplication_omp::GenerateRandomMatrix(30 * 70);
+  auto matrixB = sparse_matrix_multiplication_omp::GenerateRandomMatrix(70 * 20);
+  // Empty rows of A and empty columns of B must come out as empty rows and columns of C.
+  std::fill(matrixA.begin() + (3 * 70), matrixA.begin() + (4 * 70), 0);
+  for (int row = 0; row < 70; row++) matrixB[(row * 20) + 5] = 0;
+
+  auto first = sparse_matrix_multiplication_omp::MatrixToSparse(30, 70, matrixA);
+  auto second = sparse_matrix_multiplication_omp::MatrixToSparse(70, 20, matrixB);
+  auto expected = first * second;
+  auto inner = first.MultiplyInner(second);
+  EXPECT_TRUE(std::ranges::equal(inner.GetValues(), expected.GetValues()));
+  EXPECT_TRUE(std::ranges::equal(inner.GetRowIndices(), expected.GetRowIndices()));
+  EXPECT_TRUE(std::ranges::equal(inner.GetCumulativeElements(), expected.GetCumulativeElements()));
+
+  auto first_wide = sparse_matrix_multiplication_omp::MatrixToSparse<double, std::int64_t>(30, 70, matrixA);
+  auto second_wide = sparse_matrix_multiplication_omp::MatrixToSparse<double, std::int64_t>(70, 20, matrixB);
+  EXPECT_TRUE(std::ranges::equal(first_wide.MultiplyInner(second_wide).GetValues(), expected.GetValues()));
+
+  std::vector<float> floatsA(matrixA.begin(), matrixA.end());
+  std::vector<float> floatsB(matrixB.begin(), matrixB.end());
+  auto first_floats = sparse_matrix_multiplication_omp::MatrixToSparse(30, 70, floatsA);
+  auto second_floats = sparse_matrix_multiplication_omp::MatrixToSparse(70, 20, floatsB);
+  auto mixed = first_floats.MultiplyInner<double>(second_floats);
+  EXPECT_TRUE(std::ranges::equal(mixed.GetValues(), first_floats.Multiply<double>(second_floats).GetValues()));
+
+  // Entries that cancel are dropped as in the Gustavson kernel.
+  std::vector<double> cancelA{1, 1, 2, 0};
+  std::vector<double> cancelB{1, 3, -1, 0};
+  auto cancel_first = sparse_matrix_multiplication_omp::MatrixToSparse(2, 2, cancelA);
+  auto cancel_second = sparse_matrix_multiplication_omp::MatrixToSparse(2, 2, cancelB);
+  auto cancelled = cancel_first.MultiplyInner(cancel_second);
+  EXPECT_TRUE(std::ranges::equal(cancelled.GetRowIndices(), (cancel_first * cancel_second).GetRowIndices()));
+}
+
+TEST(sparse_matrix_multiplication_omp, test_masked_multiply) {
+  auto matrixA = sparse_matrix_multiplication_omp::GenerateRandomMatrix(30 * 40);
+  auto matrixB = sparse_matrix_multiplication_omp::GenerateRandomMatrix(40 * 30);
+  // A sparse random mask with one full column, which takes the Gustavson kernel, and one empty column.
+  std::vector<double> matrixM(30 * 30, 0);
+  std::mt19937 generator(16);
+  for (auto& value : matrixM) value = generator() % 5 == 0 ? 1 : 0;
+  for (int row = 0; row < 30; row++) {
+    matrixM[(row * 30) + 7] = 1;
+    matrixM[(row * 30) + 8] = 0;
+  }
+  auto first = sparse_matrix_multiplication_omp::MatrixToSparse(30, 40, matrixA);
+  auto second = sparse_matrix_multiplication_omp::MatrixToSparse(40, 30, matrixB);
+  auto mask = sparse_matrix_multiplication_omp::MatrixToSparse(30, 30, matrixM);
+
+  auto full = sparse_matrix_multiplication_omp::FromSparseMatrix(first * second);
+  for (size_t i = 0; i < full.size(); i++) full[i] *= matrixM[i];
+  auto expected = sparse_matrix_multiplication_omp::MatrixToSparse(30, 30, full);
+
+  auto masked = first.MultiplyMasked(second, mask);
+  EXPECT_TRUE(std::ranges::equal(masked.GetValues(), expected.GetValues()));
+  EXPECT_TRUE(std::ranges::equal(masked.GetRowIndices(), expected.GetRowIndices()));
+  EXPECT_TRUE(std::ranges::equal(masked.GetCumulativeElements(), expected.GetCumulativeElements()));
+
+  auto first_wide = sparse_matrix_multiplication_omp::MatrixToSparse<double, std::int64_t>(30, 40, matrixA);
+  auto second_wide = sparse_matrix_multiplication_omp::MatrixToSparse<double, std::int64_t>(40, 30, matrixB);
+  auto mask_wide = sparse_matrix_multiplication_omp::MatrixToSparse<double, std::int64_t>(30, 30, matrixM);
+  EXPECT_TRUE(std::ranges::equal(first_wide.MultiplyMasked(second_wide, mask_wide).GetValues(), expected.GetValues()));
+
+  EXPECT_THROW(first.MultiplyMasked(second, first), std::invalid_argument);
+}
+
+TEST(sparse_matrix_multiplication_omp, test_masked_task) {
+  // A * B = {3, 5, 2, 6}; the mask keeps the diagonal, so the nonzero C(0, 1) and C(1, 0) come out as zeros.
+  std::vector<double> matrixA{1, 2, 2, 0};
+  std::vector<double> matrixB{1, 3, 1, 1};
+  std::vector<double> mask_values{1, 1};
+  std::vector<int> mask_rows{0, 1};
+  std::vector<int> mask_cumulative{1, 2};
+  std::vector<double> result(4, -1);
+
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.push_back(reinterpret_cast<uint8_t*>(matrixA.data()));
+  taskData->inputs.push_back(reinterpret_cast<uint8_t*>(matrixB.data()));
+  taskData->inputs.push_back(reinterpret_cast<uint8_t*>(mask_values.data()));
+  taskData->inputs.push_back(reinterpret_cast<uint8_t*>(mask_rows.data()));
+  taskData->inputs.push_back(reinterpret_cast<uint8_t*>(mask_cumulative.data()));
+  taskData->inputs_count = {2, 2, 2, 2};
+  taskData->outputs.push_back(reinterpret_cast<uint8_t*>(result.data()));
+  taskData->outputs_count.push_back(result.size());
+
+  // The mask's nnz is still missing from inputs_count.
+  EXPECT_FALSE(sparse_matrix_multiplication_omp::CCSMatrixOMP(taskData).Validation());
+  taskData->inputs_count.push_back(mask_values.size());
+
+  sparse_matrix_multiplication_omp::CCSMatrixOMP multiplicationTask(taskData);
+  ASSERT_TRUE(multiplicationTask.Validation());
+  multiplicationTask.PreProcessing();
+  multiplicationTask.Run();
+  multiplicationTask.PostProcessing();
+
+  EXPECT_EQ(result, (std::vector<double>{3, 0, 0, 6}));
+  EXPECT_EQ(multiplicationTask.GetStats().output_nnz, 2U);
+}
+
+TEST(sparse_matrix_multiplication_omp, test_sparse_input_validation) {
+  // A = B = {1, 2, 0, 3} in CCS form, with a mask on the diagonal.
+  std::vector<double> values{1, 2, 3};
+  std::vector<int> rows{0, 0, 1};
+  std::vector<int> cumulative{1, 3};
+  std::vector<double> mask_values{1, 1};
+  std::vector<int> mask_rows{0, 1};
+  std::vector<int> mask_cumulative{1, 2};
+  std::vector<double> result(4, 0);
+
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  for (int operand = 0; operand < 2; operand++) {
+    taskData->inputs.push_back(reinterpret_cast<uint8_t*>(values.data()));
+    taskData->inputs.push_back(reinterpret_cast<uint8_t*>(rows.data()));
+    taskData->inputs.push_back(reinterpret_cast<uint8_t*>(cumulative.data()));
+  }
+  taskData->inputs_count = {2, 2, 2, 2, 3, 3};
+  taskData->outputs.push_back(reinterpret_cast<uint8_t*>(result.data()));
+  taskData->outputs_count.push_back(result.size());
+  ASSERT_TRUE(sparse_matrix_multiplication_omp::CCSMatrixOMP(taskData).Validation());
+
+  // The counts end short of the declared nnz.
+  taskData->inputs_count[5] = 4;
+  EXPECT_FALSE(sparse_matrix_multiplication_omp::CCSMatrixOMP(taskData).Validation());
+  taskData->inputs_count[5] = 3;
+  // The counts decrease.
+  cumulative = {3, 1};
+  EXPECT_FALSE(sparse_matrix_multiplication_omp::CCSMatrixOMP(taskData).Validation());
+  cumulative = {1, 3};
+  // A row index past the row count.
+  rows[2] = 2;
+  EXPECT_FALSE(sparse_matrix_multiplication_omp::CCSMatrixOMP(taskData).Validation());
+  // Rows out of order within a column.
+  rows = {0, 1, 0};
+  EXPECT_FALSE(sparse_matrix_multiplication_omp::CCSMatrixOMP(taskData).Validation());
+  rows = {0, 0, 1};
+  // The mask arrays are checked the same way.
+  taskData->inputs.push_back(reinterpret_cast<uint8_t*>(mask_values.data()));
+  taskData->inputs.push_back(reinterpret_cast<uint8_t*>(mask_rows.data()));
+  taskData->inputs.push_back(reinterpret_cast<uint8_t*>(mask_cumulative.data()));
+  taskData->inputs_count.push_back(mask_values.size());
+  ASSERT_TRUE(sparse_matrix_multiplication_omp::CCSMatrixOMP(taskData).Validation());
+  mask_rows[1] = -1;
+  EXPECT_FALSE(sparse_matrix_multiplication_omp::CCSMatrixOMP(taskData).Validation());
+  mask_rows[1] = 1;
+  mask_cumulative[1] = 3;
+  EXPECT_FALSE(sparse_matrix_multiplication_omp::CCSMatrixOMP(taskData).Validation());
+}
+
+TEST(sparse_matrix_multiplication_omp, test_csr_multiply) {
+  auto matrixA = sparse_matrix_multiplication_omp::GenerateRandomMatrix(30 * 40);
+  auto matrixB = sparse_matrix_multiplication_omp::GenerateRandomMatrix(40 * 25);
+  auto first = sparse_matrix_multiplication_omp::MatrixToCsr(30, 40, matrixA);
+  auto second = sparse_matrix_multiplication_omp::MatrixToCsr(40, 25, matrixB);
+  EXPECT_EQ(first.GetRowCount(), 30);
+  EXPECT_EQ(first.GetColumnCount(), 40);
+  EXPECT_EQ(sparse_matrix_multiplication_omp::FromCsrMatrix(first), matrixA);
+
+  // Both layouts hold the same entries and convert into each other.
+  auto first_ccs = sparse_matrix_multiplication_omp::MatrixToSparse(30, 40, matrixA);
+  auto converted = first.ToCcs();
+  EXPECT_TRUE(std::ranges::equal(converted.GetValues(), first_ccs.GetValues()));
+  EXPECT_TRUE(std::ranges::equal(converted.GetRowIndices(), first_ccs.GetRowIndices()));
+  EXPECT_TRUE(std::ranges::equal(converted.GetCumulativeElements(), first_ccs.GetCumulativeElements()));
+  auto round_trip = sparse_matrix_multiplication_omp::CsrMatrix::FromCcs(first_ccs);
+  EXPECT_TRUE(std::ranges::equal(round_trip.GetColumnIndices(), first.GetColumnIndices()));
+
+  sparse_matrix_multiplication_omp::MultiplyStats stats;
+  auto product = first.Multiply(second, &stats);
+  auto expected = sparse_matrix_multiplication_omp::MultiplyMatrices(matrixA, 30, 40, matrixB, 40, 25);
+  EXPECT_EQ(sparse_matrix_multiplication_omp::FromCsrMatrix(product), expected);
+  EXPECT_EQ(stats.output_nnz, product.GetValues().size());
+
+  std::vector<double> matrixM(30 * 25, 0);
+  for (size_t i = 0; i < matrixM.size(); i += 3) matrixM[i] = 1;
+  auto mask = sparse_matrix_multiplication_omp::MatrixToCsr(30, 25, matrixM);
+  auto masked = sparse_matrix_multiplication_omp::FromCsrMatrix(first.MultiplyMasked(second, mask));
+  for (size_t i = 0; i < expected.size(); i++) EXPECT_EQ(masked[i], expected[i] * matrixM[i]);
+
+  EXPECT_THROW(first * first, std::invalid_argument);
+  EXPECT_THROW(second.Multiply(second, &stats), std::invalid_argument);
+}
+
+TEST(sparse_matrix_multiplication_omp, test_csr_task) {
+  // A is 30 x 40 and B 40 x 30, so mixing up rows and columns in either layout shows.
+  auto matrixA = sparse_matrix_multiplication_omp::GenerateRandomMatrix(30 * 40);
+  auto matrixB = sparse_matrix_multiplication_omp::GenerateRandomMatrix(40 * 30);
+  auto expected = sparse_matrix_multiplication_omp::MultiplyMatrices(matrixA, 30, 40, matrixB, 40, 30);
+  std::vector<double> result(30 * 30, 0);
+
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.push_back(reinterpret_cast<uint8_t*>(matrixA.data()));
+  taskData->inputs.push_back(reinterpret_cast<uint8_t*>(matrixB.data()));
+  taskData->inputs_count = {30, 40, 40, 30};
+  taskData->outputs.push_back(reinterpret_cast<uint8_t*>(result.data()));
+  taskData->outputs_count.push_back(result.size());
+
+  const auto layout = sparse_matrix_multiplication_omp::SparseLayout::kCsr;
+  sparse_matrix_multiplication_omp::CCSMatrixOMP denseTask(taskData, layout);
+  ASSERT_TRUE(denseTask.Validation());
+  denseTask.PreProcessing();
+  denseTask.Run();
+  denseTask.PostProcessing();
+  EXPECT_EQ(result, expected);
+
+  // CSR arrays in and out.
+  auto first = sparse_matrix_multiplication_omp::MatrixToCsr(30, 40, matrixA);
+  auto second = sparse_matrix_multiplication_omp::MatrixToCsr(40, 30, matrixB);
+  std::vector<double> a_values(first.GetValues().begin(), first.GetValues().end());
+  std::vector<int> a_columns(first.GetColumnIndices().begin(), first.GetColumnIndices().end());
+  std::vector<int> a_cumulative(first.GetCumulativeElements().begin(), first.GetCumulativeElements().end());
+  std::vector<double> b_values(second.GetValues().begin(), second.GetValues().end());
+  std::vector<int> b_columns(second.GetColumnIndices().begin(), second.GetColumnIndices().end());
+  std::vector<int> b_cumulative(second.GetCumulativeElements().begin(), second.GetCumulativeElements().end());
+  std::vector<double> result_values(30 * 30, 0);
+  std::vector<int> result_columns(30 * 30, 0);
+  std::vector<int> result_cumulative(30, 0);
+
+  auto sparseData = std::make_shared<ppc::core::TaskData>();
+  sparseData->inputs = {reinterpret_cast<uint8_t*>(a_values.data()), reinterpret_cast<uint8_t*>(a_columns.data()),
+                        reinterpret_cast<uint8_t*>(a_cumulative.data()), reinterpret_cast<uint8_t*>(b_values.data()),
+                        reinterpret_cast<uint8_t*>(b_columns.data()), reinterpret_cast<uint8_t*>(b_cumulative.data())};
+  sparseData->inputs_count = {30, 40, 40, 30, static_cast<uint32_t>(a_values.size()),
+                              static_cast<uint32_t>(b_values.size())};
+  sparseData->outputs = {reinterpret_cast<uint8_t*>(result_values.data()),
+                         reinterpret_cast<uint8_t*>(result_columns.data()),
+                         reinterpret_cast<uint8_t*>(result_cumulative.data())};
+  sparseData->outputs_count = {30 * 30, 30 * 30, 30};
+
+  sparse_matrix_multiplication_omp::CCSMatrixOMP sparseTask(sparseData, layout);
+  ASSERT_TRUE(sparseTask.Validation());
+  sparseTask.PreProcessing();
+  sparseTask.Run();
+  ASSERT_TRUE(sparseTask.PostProcessing());
+
+  size_t nnz = sparseData->outputs_count[0];
+  sparse_matrix_multiplication_omp::CsrMatrix written(
+      30, 30, std::vector<double>(result_values.begin(), result_values.begin() + static_cast<std::ptrdiff_t>(nnz)),
+      std::vector<int>(result_columns.begin(), result_columns.begin() + static_cast<std::ptrdiff_t>(nnz)),
+      result_cumulative);
+  EXPECT_EQ(sparse_matrix_multiplication_omp::FromCsrMatrix(written), expected);
+  EXPECT_EQ(sparse_matrix_multiplication_omp::FromCsrMatrix(sparseTask.GetCsrResult()), expected);
+}
+
+TEST(sparse_matrix_multiplication_omp, test_chain_plan) {
+  // u * v^T * w: (u * v^T) * w goes through a dense 60 x 60 intermediate, u * (v^T * w) through a single entry.
+  std::vector<double> column(60);
+  for (size_t i = 0; i < column.size(); i++) column[i] = static_cast<double>((i % 5) + 1);
+  std::vector<sparse_matrix_multiplication_omp::SparseMatrix> operands{
+      sparse_matrix_multiplication_omp::MatrixToSparse(60, 1, column),
+      sparse_matrix_multiplication_omp::MatrixToSparse(1, 60, column),
+      sparse_matrix_multiplication_omp::MatrixToSparse(60, 1, column)};
+  sparse_matrix_multiplication_omp::ChainPlan plan(operands);
+  ASSERT_EQ(plan.GetSteps().size(), 2U);
+  EXPECT_EQ(plan.GetSteps()[0].first, 1);
+  EXPECT_EQ(plan.GetSteps()[0].second, 2);
+  EXPECT_EQ(plan.GetSteps()[1].first, 0);
+  EXPECT_EQ(plan.GetSteps()[1].second, 3);
+  auto outer = sparse_matrix_multiplication_omp::MultiplyMatrices(column, 60, 1, column, 1, 60);
+  auto expected = sparse_matrix_multiplication_omp::MultiplyMatrices(outer, 60, 60, column, 60, 1);
+  EXPECT_EQ(sparse_matrix_multiplication_omp::FromSparseMatrix(plan.Multiply(operands)), expected);
+
+  // R^T * A * P, run twice so that the second run replays the step plans into the pooled intermediates.
+  auto matrixR = sparse_matrix_multiplication_omp::GenerateRandomMatrix(12 * 40);
+  auto matrixA = sparse_matrix_multiplication_omp::GenerateRandomMatrix(40 * 40);
+  auto matrixP = sparse_matrix_multiplication_omp::GenerateRandomMatrix(40 * 12);
+  auto left = sparse_matrix_multiplication_omp::MultiplyMatrices(matrixR, 12, 40, matrixA, 40, 40);
+  auto galerkin = sparse_matrix_multiplication_omp::MultiplyMatrices(left, 12, 40, matrixP, 40, 12);
+  std::vector<sparse_matrix_multiplication_omp::SparseMatrix> chain{
+      sparse_matrix_multiplication_omp::MatrixToSparse(12, 40, matrixR),
+      sparse_matrix_multiplication_omp::MatrixToSparse(40, 40, matrixA),
+      sparse_matrix_multiplication_omp::MatrixToSparse(40, 12, matrixP)};
+  sparse_matrix_multiplication_omp::ChainPlan galerkin_plan(chain);
+  sparse_matrix_multiplication_omp::MultiplyStats stats;
+  auto product = galerkin_plan.Multiply(chain, &stats);
+  EXPECT_EQ(sparse_matrix_multiplication_omp::FromSparseMatrix(product), galerkin);
+  EXPECT_EQ(stats.output_nnz, product.GetValues().size());
+  EXPECT_GT(stats.flops, stats.output_nnz);
+  EXPECT_EQ(sparse_matrix_multiplication_omp::FromSparseMatrix(galerkin_plan.Multiply(chain)), galerkin);
+
+  EXPECT_THROW(galerkin_plan.Multiply(operands), std::invalid_argument);
+  std::vector<sparse_matrix_multiplication_omp::SparseMatrix> mismatched{operands[0], operands[0]};
+  EXPECT_THROW(sparse_matrix_multiplication_omp::ChainPlan{mismatched}, std::invalid_argument);
+}
+
+TEST(sparse_matrix_multiplication_omp, test_chain_task) {
+  auto matrixR = sparse_matrix_multiplication_omp::GenerateRandomMatrix(12 * 40);
+  auto matrixA = sparse_matrix_multiplication_omp::GenerateRandomMatrix(40 * 40);
+  auto matrixP = sparse_matrix_multiplication_omp::GenerateRandomMatrix(40 * 12);
+  auto left = sparse_matrix_multiplication_omp::MultiplyMatrices(matrixR, 12, 40, matrixA, 40, 40);
+  auto expected = sparse_matrix_multiplication_omp::MultiplyMatrices(left, 12, 40, matrixP, 40, 12);
+
+  for (auto layout : {sparse_matrix_multiplication_omp::SparseLayout::kCcs,
+                      sparse_matrix_multiplication_omp::SparseLayout::kCsr}) {
+    std::vector<double> result(12 * 12, 0);
+    auto taskData = std::make_shared<ppc::core::TaskData>();
+    taskData->inputs = {reinterpret_cast<uint8_t*>(matrixR.data()), reinterpret_cast<uint8_t*>(matrixA.data()),
+                        reinterpret_cast<uint8_t*>(matrixP.data())};
+    taskData->inputs_count = {12, 40, 40, 40, 40, 12};
+    taskData->outputs.push_back(reinterpret_cast<uint8_t*>(result.data()));
+    taskData->outputs_count.push_back(result.size());
+
+    sparse_matrix_multiplication_omp::CCSChainOMP chainTask(taskData, layout);
+    ASSERT_TRUE(chainTask.Validation());
+    chainTask.PreProcessing();
+    chainTask.Run();
+    chainTask.PostProcessing();
+    EXPECT_EQ(result, expected);
+
+    taskData->inputs_count[3] = 41;
+    EXPECT_FALSE(sparse_matrix_multiplication_omp::CCSChainOMP(taskData, layout).Validation());
+  }
+
+  // CCS arrays in and out.
+  std::vector<sparse_matrix_multiplication_omp::SparseMatrix> operands{
+      sparse_matrix_multiplication_omp::MatrixToSparse(12, 40, matrixR),
+      sparse_matrix_multiplication_omp::MatrixToSparse(40, 40, matrixA),
+      sparse_matrix_multiplication_omp::MatrixToSparse(40, 12, matrixP)};
+  std::vector<std::vector<double>> values;
+  std::vector<std::vector<int>> rows;
+  std::vector<std::vector<int>> cumulative;
+  for (const auto& operand : operands) {
+    values.emplace_back(operand.GetValues().begin(), operand.GetValues().end());
+    rows.emplace_back(operand.GetRowIndices().begin(), operand.GetRowIndices().end());
+    cumulative.emplace_back(operand.GetCumulativeElements().begin(), operand.GetCumulativeElements().end());
+  }
+  std::vector<double> result_values(12 * 12, 0);
+  std::vector<int> result_rows(12 * 12, 0);
+  std::vector<int> result_cumulative(12, 0);
+
+  auto sparseData = std::make_shared<ppc::core::TaskData>();
+  sparseData->inputs_count = {12, 40, 40, 40, 40, 12};
+  for (size_t i = 0; i < operands.size(); i++) {
+    sparseData->inputs.push_back(reinterpret_cast<uint8_t*>(values[i].data()));
+    sparseData->inputs.push_back(reinterpret_cast<uint8_t*>(rows[i].data()));
+    sparseData->inputs.push_back(reinterpret_cast<uint8_t*>(cumulative[i].data()));
+  }
+  for (const auto& operand_values : values) {
+    sparseData->inputs_count.push_back(static_cast<uint32_t>(operand_values.size()));
+  }
+  sparseData->outputs = {reinterpret_cast<uint8_t*>(result_values.data()),
+                         reinterpret_cast<uint8_t*>(result_rows.data()),
+                         reinterpret_cast<uint8_t*>(result_cumulative.data())};
+  sparseData->outputs_count = {12 * 12, 12 * 12, 12};
+
+  sparse_matrix_multiplication_omp::CCSChainOMP sparseTask(sparseData);
+  ASSERT_TRUE(sparseTask.Validation());
+  sparseTask.PreProcessing();
+  sparseTask.Run();
+  sparseTask.PostProcessing();
+  result_values.resize(sparseData->outputs_count[0]);
+  result_rows.resize(sparseData->outputs_count[1]);
+  sparse_matrix_multiplication_omp::SparseMatrix product(12, 12, result_values, result_rows, result_cumulative);
+  EXPECT_EQ(sparse_matrix_multiplication_omp::FromSparseMatrix(product), expected);
+
+  // A row index of A past its 40 rows.
+  rows[1].back() = 40;
+  EXPECT_FALSE(sparse_matrix_multiplication_omp::CCSChainOMP(sparseData).Validation());
+}
+
+TEST(sparse_matrix_multiplication_omp, test_block_sparse_round_trip) {
+  // 17 x 22 is no multiple of most block sizes, so the last block row and column are padded.
+  auto dense = sparse_matrix_multiplication_omp::GenerateRandomMatrix(17 * 22);
+  auto matrix = sparse_matrix_multiplication_omp::MatrixToSparse(17, 22, dense);
+  for (int block_size : {1, 3, 5, 22}) {
+    auto blocks = sparse_matrix_multiplication_omp::BlockSparseMatrix::FromSparse(matrix, block_size);
+    EXPECT_EQ(blocks.GetBlockColumnCount(), (22 + block_size - 1) / block_size);
+    EXPECT_EQ(blocks.GetValues().size(), blocks.GetBlockRows().size() * block_size * block_size);
+    auto back = blocks.ToSparse();
+    EXPECT_TRUE(std::ranges::equal(back.GetValues(), matrix.GetValues()));
+    EXPECT_TRUE(std::ranges::equal(back.GetRowIndices(), matrix.GetRowIndices()));
+    EXPECT_TRUE(std::ranges::equal(back.GetCumulativeElements(), matrix.GetCumulativeElements()));
+  }
+  EXPECT_THROW(sparse_matrix_multiplication_omp::BlockSparseMatrix::FromSparse(matrix, 0), std::invalid_argument);
+}
+
+TEST(sparse_matrix_multiplication_omp, test_block_multiply_matches_ccs) {
+  // Dense blocks on a random block pattern, like an FEM operator with block_size unknowns per node. Sizes 2, 3 and 6
+  // take the unrolled kernels, 1 and 5 the generic one.
+  std::mt19937 generator(18);
+  auto blocky = [&](int rows_count, int cols_count, int block_size) {
+    std::vector<double> dense(static_cast<size_t>(rows_count) * cols_count, 0);
+    for (int first_row = 0; first_row < rows_count; first_row += block_size) {
+      for (int first_col = 0; first_col < cols_count; first_col += block_size) {
+        if (generator() % 3 != 0) continue;
+        for (int row = first_row; row < std::min(rows_count, first_row + block_size); row++) {
+          for (int col = first_col; col < std::min(cols_count, first_col + block_size); col++) {
+            dense[(static_cast<size_t>(row) * cols_count) + col] = static_cast<double>(generator() % 9) + 1;
+          }
+        }
+      }
+    }
+    return dense;
+  };
+
+  for (int block_size : {1, 2, 3, 5, 6}) {
+    auto matrixA = blocky(31, 25, block_size);
+    auto matrixB = blocky(25, 28, block_size);
+    auto first = sparse_matrix_multiplication_omp::MatrixToSparse(31, 25, matrixA);
+    auto second = sparse_matrix_multiplication_omp::MatrixToSparse(25, 28, matrixB);
+    auto expected = first * second;
+    auto product = sparse_matrix_multiplication_omp::BlockSparseMatrix::FromSparse(first, block_size) *
+                   sparse_matrix_multiplication_omp::BlockSparseMatrix::FromSparse(second, block_size);
+    auto result = product.ToSparse();
+    EXPECT_TRUE(std::ranges::equal(result.GetValues(), expected.GetValues()));
+    EXPECT_TRUE(std::ranges::equal(result.GetRowIndices(), expected.GetRowIndices()));
+    EXPECT_TRUE(std::ranges::equal(result.GetCumulativeElements(), expected.GetCumulativeElements()));
+
+    using WideBlocks = sparse_matrix_multiplication_omp::BasicBlockSparseMatrix<double, std::int64_t>;
+    auto first_wide = sparse_matrix_multiplication_omp::MatrixToSparse<double, std::int64_t>(31, 25, matrixA);
+    auto second_wide = sparse_matrix_multiplication_omp::MatrixToSparse<double, std::int64_t>(25, 28, matrixB);
+    auto wide = WideBlocks::FromSparse(first_wide, block_size) * WideBlocks::FromSparse(second_wide, block_size);
+    EXPECT_TRUE(std::ranges::equal(wide.ToSparse().GetValues(), expected.GetValues()));
+  }
+
+  auto square = sparse_matrix_multiplication_omp::MatrixToSparse(31, 25, blocky(31, 25, 1));
+  auto threes = sparse_matrix_multiplication_omp::BlockSparseMatrix::FromSparse(square, 3);
+  EXPECT_THROW(threes * threes, std::invalid_argument);
+  auto transposed = sparse_matrix_multiplication_omp::SparseMatrix::ComputeTranspose(square);
+  EXPECT_THROW(threes * sparse_matrix_multiplication_omp::BlockSparseMatrix::FromSparse(transposed, 2),
+               std::invalid_argument);
+}
+
+TEST(sparse_matrix_multiplication_omp, test_addition_and_scaling) {
+  auto matrixA = sparse_matrix_multiplication_omp::GenerateRandomMatrix(20 * 30);
+  auto matrixB = sparse_matrix_multiplication_omp::GenerateRandomMatrix(20 * 30);
+  // Column 4 of B cancels column 4 of A, so the sum has to leave it empty rather than store zeros.
+  for (int row = 0; row < 20; row++) matrixB[(row * 30) + 4] = -matrixA[(row * 30) + 4];
+  auto first = sparse_matrix_multiplication_omp::MatrixToSparse(20, 30, matrixA);
+  auto second = sparse_matrix_multiplication_omp::MatrixToSparse(20, 30, matrixB);
+  std::vector<double> sum(matrixA.size());
+  std::ranges::transform(matrixA, matrixB, sum.begin(), std::plus<>());
+  auto expected = sparse_matrix_multiplication_omp::MatrixToSparse(20, 30, sum);
+
+  auto result = first + second;
+  EXPECT_TRUE(std::ranges::equal(result.GetValues(), expected.GetValues()));
+  EXPECT_TRUE(std::ranges::equal(result.GetRowIndices(), expected.GetRowIndices()));
+  EXPECT_TRUE(std::ranges::equal(result.GetCumulativeElements(), expected.GetCumulativeElements()));
+  EXPECT_EQ(result.GetCumulativeElements()[4], result.GetCumulativeElements()[3]);
+  auto accumulated = first;
+  accumulated += second;
+  EXPECT_TRUE(std::ranges::equal(accumulated.GetValues(), expected.GetValues()));
+
+  auto scaled = -0.5 * first;
+  EXPECT_EQ(scaled.GetRowIndices().data(), first.GetRowIndices().data());
+  for (size_t i = 0; i < first.GetValues().size(); i++) EXPECT_EQ(scaled.GetValues()[i], -0.5 * first.GetValues()[i]);
+  scaled *= -2;
+  EXPECT_TRUE(std::ranges::equal(scaled.GetValues(), first.GetValues()));
+  auto zero = first * 0.0;
+  EXPECT_TRUE(zero.GetValues().empty());
+  EXPECT_EQ(zero.GetCumulativeElements().size(), 30U);
+
+  EXPECT_THROW(first + sparse_matrix_multiplication_omp::SparseMatrix::ComputeTranspose(first), std::invalid_argument);
+}
+
+TEST(sparse_matrix_multiplication_omp, test_multiply_transposed) {
+  auto matrixA = sparse_matrix_multiplication_omp::GenerateRandomMatrix(40 * 25);
+  auto matrixB = sparse_matrix_multiplication_omp::GenerateRandomMatrix(40 * 30);
+  auto first = sparse_matrix_multiplication_omp::MatrixToSparse(40, 25, matrixA);
+  auto second = sparse_matrix_multiplication_omp::MatrixToSparse(40, 30, matrixB);
+  auto transposed = sparse_matrix_multiplication_omp::SparseMatrix::ComputeTranspose(first);
+  auto expected = transposed * second;
+  auto fused = first.MultiplyTransposed(second);
+  EXPECT_EQ(fused.GetRowCount(), 25);
+  EXPECT_TRUE(std::ranges::equal(fused.GetValues(), expected.GetValues()));
+  EXPECT_TRUE(std::ranges::equal(fused.GetRowIndices(), expected.GetRowIndices()));
+  EXPECT_TRUE(std::ranges::equal(fused.GetCumulativeElements(), expected.GetCumulativeElements()));
+
+  // A^T A + 2 I, the normal equations of a ridge regression, assembled without a dense intermediate.
+  std::vector<double> identity(25 * 25, 0);
+  for (int i = 0; i < 25; i++) identity[(i * 25) + i] = 1;
+  auto ridge = 2.0 * sparse_matrix_multiplication_omp::MatrixToSparse(25, 25, identity);
+  auto normal = first.MultiplyTransposed(first) + ridge;
+  auto dense_normal = sparse_matrix_multiplication_omp::MultiplyMatrices(
+      sparse_matrix_multiplication_omp::FromSparseMatrix(transposed), 25, 40, matrixA, 40, 25);
+  for (int i = 0; i < 25; i++) dense_normal[(i * 25) + i] += 2;
+  EXPECT_EQ(sparse_matrix_multiplication_omp::FromSparseMatrix(normal), dense_normal);
+
+  auto first_wide = sparse_matrix_multiplication_omp::MatrixToSparse<double, std::int64_t>(40, 25, matrixA);
+  auto second_wide = sparse_matrix_multiplication_omp::MatrixToSparse<double, std::int64_t>(40, 30, matrixB);
+  EXPECT_TRUE(std::ranges::equal(first_wide.MultiplyTransposed(second_wide).GetValues(), expected.GetValues()));
+
+  EXPECT_THROW(first.MultiplyTransposed(transposed), std::invalid_argument);
+  EXPECT_THROW(first * second, std::invalid_argument);
+  EXPECT_THROW(sparse_matrix_multiplication_omp::SpGEMMPlan(first, second), std::invalid_argument);
+}
+
+TEST(sparse_matrix_multiplication_omp, test_generators_are_seeded) {
+  auto matrix = sparse_matrix_multiplication_omp::GenerateUniform(300, 200, 0.05, 7);
+  auto again = sparse_matrix_multiplication_omp::GenerateUniform(300, 200, 0.05, 7);
+  auto other = sparse_matrix_multiplication_omp::GenerateUniform(300, 200, 0.05, 8);
+  EXPECT_TRUE(std::ranges::equal(matrix.GetValues(), again.GetValues()));
+  EXPECT_TRUE(std::ranges::equal(matrix.GetRowIndices(), again.GetRowIndices()));
+  EXPECT_FALSE(std::ranges::equal(matrix.GetRowIndices(), other.GetRowIndices()));
+  // 3000 entries are expected; the binomial spread is about 53.
+  EXPECT_NEAR(static_cast<double>(matrix.GetValues().size()), 3000, 300);
+
+  // Rows come out sorted and distinct within every column, and values are whole numbers in [1, 9].
+  auto check_columns = [](const auto& generated) {
+    auto sums = generated.GetCumulativeElements();
+    auto rows = generated.GetRowIndices();
+    for (int col = 0; col < generated.GetColumnCount(); col++) {
+      for (auto i = (col == 0 ? 0 : sums[col - 1]) + 1; i < sums[col]; i++) EXPECT_LT(rows[i - 1], rows[i]);
+    }
+    for (auto value : generated.GetValues()) EXPECT_TRUE(value >= 1 && value <= 9 && value == std::floor(value));
+  };
+  check_columns(matrix);
+
+  auto wide = sparse_matrix_multiplication_omp::GenerateUniform<float, std::int64_t>(300, 200, 0.05, 7);
+  EXPECT_TRUE(std::ranges::equal(wide.GetRowIndices(), matrix.GetRowIndices()));
+  check_columns(wide);
+
+  EXPECT_TRUE(sparse_matrix_multiplication_omp::GenerateUniform(50, 40, 0, 1).GetValues().empty());
+  EXPECT_EQ(sparse_matrix_multiplication_omp::GenerateUniform(50, 40, 1, 1).GetValues().size(), 2000U);
+  EXPECT_THROW(sparse_matrix_multiplication_omp::GenerateUniform(50, 40, 1.5, 1), std::invalid_argument);
+  EXPECT_THROW(sparse_matrix_multiplication_omp::GenerateUniform(-1, 40, 0.5, 1), std::invalid_argument);
+}
+
+TEST(sparse_matrix_multiplication_omp, test_structured_generators) {
+  // A full band and full blocks have known entry counts; thinner ones must stay inside them.
+  auto banded = sparse_matrix_multiplication_omp::GenerateBanded(100, 2, 3, 1, 1);
+  EXPECT_EQ(banded.GetValues().size(), static_cast<size_t>((100 * 6) - (3 + 2 + 1) - (2 + 1)));
+  auto thin_band = sparse_matrix_multiplication_omp::GenerateBanded(100, 2, 3, 0.5, 1);
+  auto dense_band = sparse_matrix_multiplication_omp::FromSparseMatrix(thin_band);
+  for (int row = 0; row < 100; row++) {
+    for (int col = 0; col < 100; col++) {
+      if (col - row > 3 || row - col > 2) {
+        EXPECT_EQ(dense_band[(row * 100) + col], 0);
+      }
+    }
+  }
+
+  auto blocks = sparse_matrix_multiplication_omp::GenerateBlockDiagonal(50, 6, 1, 1);
+  EXPECT_EQ(blocks.GetValues().size(), static_cast<size_t>((8 * 36) + 4));
+  auto dense_blocks = sparse_matrix_multiplication_omp::FromSparseMatrix(
+      sparse_matrix_multiplication_omp::GenerateBlockDiagonal(50, 6, 0.5, 1));
+  for (int row = 0; row < 50; row++) {
+    for (int col = 0; col < 50; col++) {
+      if (row / 6 != col / 6) {
+        EXPECT_EQ(dense_blocks[(row * 50) + col], 0);
+      }
+    }
+  }
+
+  // R-MAT concentrates edges on low indices: column 0 collects far more than the average column.
+  auto graph = sparse_matrix_multiplication_omp::GenerateRMat(10, 0.01, 3);
+  EXPECT_EQ(graph.GetColumnCount(), 1024);
+  auto sums = graph.GetCumulativeElements();
+  double average = static_cast<double>(graph.GetValues().size()) / 1024;
+  EXPECT_GT(sums[0], 10 * average);
+  auto same = sparse_matrix_multiplication_omp::GenerateRMat(10, 0.01, 3);
+  EXPECT_TRUE(std::ranges::equal(graph.GetRowIndices(), same.GetRowIndices()));
+  EXPECT_THROW(sparse_matrix_multiplication_omp::GenerateRMat(10, 0.01, 3, 0.6, 0.3, 0.3), std::invalid_argument);
+  EXPECT_THROW(sparse_matrix_multiplication_omp::GenerateBlockDiagonal(50, 0, 0.5, 1), std::invalid_argument);
+}
+
+TEST(sparse_matrix_multiplication_omp, test_transpose) {
+  std::vector<double> matrix{0, 1, 0, 6, 0, 0, 0, 0, 4, 3, 0, 2};
+  std::vector<double> expectedOutput{0, 0, 4, 1, 0, 3, 0, 0, 0, 6, 0, 2};
+
+  auto sparse = sparse_matrix_multiplication_omp::MatrixToSparse(3, 4, matrix);
+  auto transposed = sparse_matrix_multiplication_omp::SparseMatrix::ComputeTranspose(sparse);
+
+  ASSERT_EQ(transposed.GetRowCount(), 4);
+  ASSERT_EQ(transposed.GetColumnCount(), 3);
+  EXPECT_EQ(sparse_matrix_multiplication_omp::FromSparseMatrix(transposed), expectedOutput);
+
+  auto restored = sparse_matrix_multiplication_omp::SparseMatrix::ComputeTranspose(transposed);
+  EXPECT_TRUE(std::ranges::equal(restored.GetValues(), sparse.GetValues()));
+  EXPECT_TRUE(std::ranges::equal(restored.GetRowIndices(), sparse.GetRowIndices()));
+  EXPECT_TRUE(std::ranges::equal(restored.GetCumulativeElements(), sparse.GetCumulativeElements()));
+}
+
+TEST(sparse_matrix_multiplication_omp, test_wide_indices_match_narrow) {
+  const auto epsilon = 1e-6;
+  using WideMatrix = sparse_matrix_multiplication_omp::BasicSparseMatrix<double, std::int64_t>;
+
+  std::vector<double> matrixA{0, 1, 0, 6, 0, 0, 4, 3, 1, 0, 0, 2};
+  std::vector<double> matrixB{0.5, 0, 1.5, 0, 0, 8.0, 3.0, 0, 0, 7, 0, 2};
+  auto narrow = sparse_matrix_multiplication_omp::MatrixToSparse(3, 4, matrixA) *
+                sparse_matrix_multiplication_omp::MatrixToSparse(4, 3, matrixB);
+  auto wide = sparse_matrix_multiplication_omp::MatrixToSparse<double, std::int64_t>(3, 4, matrixA) *
+              sparse_matrix_multiplication_omp::MatrixToSparse<double, std::int64_t>(4, 3, matrixB);
+
+  EXPECT_TRUE(std::ranges::equal(wide.GetRowIndices(), narrow.GetRowIndices()));
+  EXPECT_TRUE(std::ranges::equal(wide.GetCumulativeElements(), narrow.GetCumulativeElements()));
+  auto dense = sparse_matrix_multiplication_omp::FromSparseMatrix(WideMatrix::ComputeTranspose(wide));
+  auto expected = sparse_matrix_multiplication_omp::FromSparseMatrix(
+      sparse_matrix_multiplication_omp::SparseMatrix::ComputeTranspose(narrow));
+  ASSERT_EQ(dense.size(), expected.size());
+  for (size_t i = 0; i < dense.size(); i++) EXPECT_NEAR(dense[i], expected[i], epsilon) << "Mismatch at index " << i;
+}
+
+TEST(sparse_matrix_multiplication_omp, test_needs_wide_indices) {
+  EXPECT_FALSE(sparse_matrix_multiplication_omp::NeedsWideIndices(1000000, 1000000, 2147483647));
+  EXPECT_TRUE(sparse_matrix_multiplication_omp::NeedsWideIndices(2147483648, 1, 1));
+  EXPECT_TRUE(sparse_matrix_multiplication_omp::NeedsWideIndices(1, 1, 2147483648));
+
+  // A 100000 x 100000 diagonal has a shape past 32-bit offsets but few entries, so it stays on int indices.
+  const int size = 100000;
+  std::vector<double> values(size, 2);
+  std::vector<int> rows(size);
+  std::iota(rows.begin(), rows.end(), 0);
+  std::vector<int> cumulative(size);
+  std::iota(cumulative.begin(), cumulative.end(), 1);
+  std::vector<double> result_values(size, 0);
+  std::vector<int> result_rows(size, 0);
+  std::vector<int> result_cumulative(size, 0);
+
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  for (int operand = 0; operand < 2; operand++) {
+    taskData->inputs.push_back(reinterpret_cast<uint8_t*>(values.data()));
+    taskData->inputs.push_back(reinterpret_cast<uint8_t*>(rows.data()));
+    taskData->inputs.push_back(reinterpret_cast<uint8_t*>(cumulative.data()));
+  }
+  taskData->inputs_count = {size, size, size, size, size, size};
+  taskData->outputs = {reinterpret_cast<uint8_t*>(result_values.data()),
+                       reinterpret_cast<uint8_t*>(result_rows.data()),
+                       reinterpret_cast<uint8_t*>(result_cumulative.data())};
+  taskData->outputs_count = {size, size, size};
+
+  sparse_matrix_multiplication_omp::CCSMatrixOMP multiplicationTask(taskData);
+  ASSERT_TRUE(multiplicationTask.Validation());
+  multiplicationTask.PreProcessing();
+  multiplicationTask.Run();
+  multiplicationTask.PostProcessing();
+  EXPECT_EQ(multiplicationTask.GetResult<int>().GetValues().size(), static_cast<size_t>(size));
+  EXPECT_EQ(result_values.front(), 4);
+
+  sparse_matrix_multiplication_omp::CCSChainOMP chainTask(taskData);
+  ASSERT_TRUE(chainTask.Validation());
+  chainTask.PreProcessing();
+  chainTask.Run();
+  chainTask.PostProcessing();
+  EXPECT_EQ(chainTask.GetResult<int>().GetValues().size(), static_cast<size_t>(size));
+}
+
+TEST(sparse_matrix_multiplication_omp, test_partition_columns_balances_cost) {
+  // One heavy column among light ones ends up alone, and the light ones are split around it.
+  std::vector<size_t> costs(16, 1);
+  costs[5] = 100;
+  auto bounds = sparse_matrix_multiplication_omp::PartitionColumns(costs, 4);
+  ASSERT_GE(bounds.size(), 3U);
+  EXPECT_EQ(bounds.front(), 0);
+  EXPECT_EQ(bounds.back(), 16);
+  EXPECT_TRUE(std::ranges::is_sorted(bounds));
+  EXPECT_TRUE(std::ranges::adjacent_find(bounds) == bounds.end());
+  EXPECT_TRUE(std::ranges::find(bounds, 5) != bounds.end());
+  EXPECT_TRUE(std::ranges::find(bounds, 6) != bounds.end());
+
+  EXPECT_EQ(sparse_matrix_multiplication_omp::PartitionColumns(std::vector<size_t>(3, 0), 8),
+            std::vector<int>({0, 1, 2, 3}));
+  EXPECT_EQ(sparse_matrix_multiplication_omp::PartitionColumns({}, 4), std::vector<int>({0}));
+}
+
+TEST(sparse_matrix_multiplication_omp, test_float_and_mixed_precision) {
+  const auto size = 60;
+  const auto float_tolerance = 1e-5;
+  const auto mixed_tolerance = 1e-6;
+
+  // Non-integral entries so that float storage and float sums both round.
+  std::vector<double> matrixA(size * size, 0);
+  std::vector<double> matrixB(size * size, 0);
+  for (int i = 0; i < size * size; i++) {
+    if (i % 3 != 0) matrixA[i] = 0.1 + ((i * 37) % 101) / 97.0;
+    if (i % 4 != 1) matrixB[i] = 0.2 + ((i * 53) % 89) / 83.0;
+  }
+  std::vector<float> floatA(matrixA.begin(), matrixA.end());
+  std::vector<float> floatB(matrixB.begin(), matrixB.end());
+
+  auto first = sparse_matrix_multiplication_omp::MatrixToSparse(size, size, floatA);
+  auto second = sparse_matrix_multiplication_omp::MatrixToSparse(size, size, floatB);
+  auto single = sparse_matrix_multiplication_omp::FromSparseMatrix(first * second);
+  auto mixed = sparse_matrix_multiplication_omp::FromSparseMatrix(first.Multiply<double>(second));
+  auto expected = sparse_matrix_multiplication_omp::MultiplyMatrices(matrixA, size, size, matrixB, size, size);
+
+  ASSERT_EQ(single.size(), expected.size());
+  ASSERT_EQ(mixed.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_LE(std::abs(single[i] - expected[i]), float_tolerance * expected[i]) << "Mismatch at index " << i;
+    EXPECT_LE(std::abs(mixed[i] - expected[i]), mixed_tolerance * expected[i]) << "Mismatch at index " << i;
+  }
+}
+
+TEST(sparse_matrix_multiplication_omp, test_sparse_input_and_output) {
+  const auto epsilon = 1e-6;
+
+  std::vector<double> matrixA{0, 1, 0, 6, 0, 0, 4, 3, 1, 0, 0, 2};
+  std::vector<double> matrixB{0.5, 0, 1.5, 0, 0, 8.0, 3.0, 0, 0, 7, 0, 2};
+  auto first = sparse_matrix_multiplication_omp::MatrixToSparse(3, 4, matrixA);
+  auto second = sparse_matrix_multiplication_omp::MatrixToSparse(4, 3, matrixB);
+
+  std::vector<double> a_values(first.GetValues().begin(), first.GetValues().end());
+  std::vector<int> a_rows(first.GetRowIndices().begin(), first.GetRowIndices().end());
+  std::vector<int> a_cumulative(first.GetCumulativeElements().begin(), first.GetCumulativeElements().end());
+  std::vector<double> b_values(second.GetValues().begin(), second.GetValues().end());
+  std::vector<int> b_rows(second.GetRowIndices().begin(), second.GetRowIndices().end());
+  std::vector<int> b_cumulative(second.GetCumulativeElements().begin(), second.GetCumulativeElements().end());
+
+  std::vector<double> result_values(9, 0);
+  std::vector<int> result_rows(9, 0);
+  std::vector<int> result_cumulative(3, 0);
+
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs = {reinterpret_cast<uint8_t*>(a_values.data()), reinterpret_cast<uint8_t*>(a_rows.data()),
+                      reinterpret_cast<uint8_t*>(a_cumulative.data()), reinterpret_cast<uint8_t*>(b_values.data()),
+                      reinterpret_cast<uint8_t*>(b_rows.data()), reinterpret_cast<uint8_t*>(b_cumulative.data())};
+  taskData->inputs_count = {3, 4, 4, 3, static_cast<uint32_t>(a_values.size()),
+                            static_cast<uint32_t>(b_values.size())};
+  taskData->outputs = {reinterpret_cast<uint8_t*>(result_values.data()),
+                       reinterpret_cast<uint8_t*>(result_rows.data()),
+                       reinterpret_cast<uint8_t*>(result_cumulative.data())};
+  taskData->outputs_count = {9, 9, 3};
+
+  sparse_matrix_multiplication_omp::CCSMatrixOMP multiplicationTask(taskData);
+  ASSERT_TRUE(multiplicationTask.Validation()) << "Validation failed!";
+
+  multiplicationTask.PreProcessing();
+  multiplicationTask.Run();
+  ASSERT_TRUE(multiplicationTask.PostProcessing());
+
+  auto expected = first * second;
+  ASSERT_EQ(taskData->outputs_count[0], expected.GetValues().size());
+  for (size_t i = 0; i < expected.GetValues().size(); i++) {
+    EXPECT_NEAR(result_values[i], expected.GetValues()[i], epsilon) << "Mismatch at index " << i;
+    EXPECT_EQ(result_rows[i], expected.GetRowIndices()[i]) << "Mismatch at index " << i;
+  }
+  EXPECT_TRUE(std::ranges::equal(result_cumulative, expected.GetCumulativeElements()));
+}
+
+TEST(sparse_matrix_multiplication_omp, test_sparse_input_dense_output) {
+  const auto epsilon = 1e-6;
+
+  std::vector<double> matrixA{1, 0, 2, 0, 7, 6, 0, 0, 3};
+  std::vector<double> matrixB{0, 3, 10, 1, 0, 0, 4, 0, 0};
+  auto first = sparse_matrix_multiplication_omp::MatrixToSparse(3, 3, matrixA);
+  auto second = sparse_matrix_multiplication_omp::MatrixToSparse(3, 3, matrixB);
+
+  std::vector<double> a_values(first.GetValues().begin(), first.GetValues().end());
+  std::vector<int> a_rows(first.GetRowIndices().begin(), first.GetRowIndices().end());
+  std::vector<int> a_cumulative(first.GetCumulativeElements().begin(), first.GetCumulativeElements().end());
+  std::vector<double> b_values(second.GetValues().begin(), second.GetValues().end());
+  std::vector<int> b_rows(second.GetRowIndices().begin(), second.GetRowIndices().end());
+  std::vector<int> b_cumulative(second.GetCumulativeElements().begin(), second.GetCumulativeElements().end());
+
+  std::vector<double> expectedOutput{8, 3, 10, 31, 0, 0, 12, 0, 0};
+  std::vector<double> result(9, 0);
+
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs = {reinterpret_cast<uint8_t*>(a_values.data()), reinterpret_cast<uint8_t*>(a_rows.data()),
+                      reinterpret_cast<uint8_t*>(a_cumulative.data()), reinterpret_cast<uint8_t*>(b_values.data()),
+                      reinterpret_cast<uint8_t*>(b_rows.data()), reinterpret_cast<uint8_t*>(b_cumulative.data())};
+  taskData->inputs_count = {3, 3, 3, 3, static_cast<uint32_t>(a_values.size()),
+                            static_cast<uint32_t>(b_values.size())};
+  taskData->outputs.push_back(reinterpret_cast<uint8_t*>(result.data()));
+  taskData->outputs_count.push_back(result.size());
+
+  sparse_matrix_multiplication_omp::CCSMatrixOMP multiplicationTask(taskData);
+  ASSERT_TRUE(multiplicationTask.Validation()) << "Validation failed!";
+
+  multiplicationTask.PreProcessing();
+  multiplicationTask.Run();
+  multiplicationTask.PostProcessing();
+
+  for (size_t i = 0; i < result.size(); i++)
+    EXPECT_NEAR(result[i], expectedOutput[i], epsilon) << "Mismatch at index " << i;
+}
+
+TEST(sparse_matrix_multiplication_omp, test_read_matrix_market) {
+  const auto epsilon = 1e-6;
+  const auto grid = 4;
+  const auto size = grid * grid;
+
+  auto matrix = sparse_matrix_multiplication_omp::ReadMatrixMarket(
+      ppc::util::GetAbsolutePath("omp/sparse_matrix/data/grid_4x4.mtx"));
+  ASSERT_EQ(matrix.GetRowCount(), size);
+  ASSERT_EQ(matrix.GetColumnCount(), size);
+  ASSERT_EQ(matrix.GetValues().size(), 48U);
+
+  std::vector<double> expected(size * size, 0);
+  for (int v = 0; v < size; v++) {
+    if (v % grid + 1 < grid) expected[(v * size) + v + 1] = expected[((v + 1) * size) + v] = 1;
+    if (v + grid < size) expected[(v * size) + v + grid] = expected[((v + grid) * size) + v] = 1;
+  }
+  EXPECT_EQ(sparse_matrix_multiplication_omp::FromSparseMatrix(matrix), expected);
+
+  auto squared = sparse_matrix_multiplication_omp::FromSparseMatrix(matrix * matrix);
+  auto expectedSquared = sparse_matrix_multiplication_omp::MultiplyMatrices(expected, size, size, expected, size, size);
+  for (size_t i = 0; i < squared.size(); i++)
+    EXPECT_NEAR(squared[i], expectedSquared[i], epsilon) << "Mismatch at index " << i;
+}
+
+TEST(sparse_matrix_multiplication_omp, test_matrix_market_round_trip) {
+  std::vector<double> dense{0, 1.25, 0, 6, 0, 0, -4, 3e-3, 1, 0, 0, 2};
+  auto matrix = sparse_matrix_multiplication_omp::MatrixToSparse(3, 4, dense);
+  auto path = (std::filesystem::temp_directory_path() / "sparse_matrix_omp_round_trip.mtx").string();
+
+  sparse_matrix_multiplication_omp::WriteMatrixMarket(path, matrix);
+  auto restored = sparse_matrix_multiplication_omp::ReadMatrixMarket(path);
+  std::filesystem::remove(path);
+
+  EXPECT_EQ(restored.GetRowCount(), 3);
+  EXPECT_EQ(restored.GetColumnCount(), 4);
+  EXPECT_TRUE(std::ranges::equal(restored.GetValues(), matrix.GetValues()));
+  EXPECT_TRUE(std::ranges::equal(restored.GetRowIndices(), matrix.GetRowIndices()));
+  EXPECT_TRUE(std::ranges::equal(restored.GetCumulativeElements(), matrix.GetCumulativeElements()));
+}
+
+TEST(sparse_matrix_multiplication_omp, test_read_matrix_market_duplicates) {
+  auto path = (std::filesystem::temp_directory_path() / "sparse_matrix_omp_duplicates.mtx").string();
+  auto write = [&](const char* text) {
+    std::ofstream out(path);
+    out << text;
+  };
+
+  // Repeats of (1, 1) add up and those of (2, 1) cancel.
+  write("%%MatrixMarket matrix coordinate real general\n3 2 6\n1 1 2.0\n3 1 1.0\n1 1 3.0\n2 1 4.0\n2 1 -4.0\n1 2 5\n");
+  auto matrix = sparse_matrix_multiplication_omp::ReadMatrixMarket(path);
+  EXPECT_EQ(sparse_matrix_multiplication_omp::FromSparseMatrix(matrix), (std::vector<double>{5, 5, 0, 0, 1, 0}));
+  EXPECT_TRUE(std::ranges::equal(matrix.GetRowIndices(), std::vector<int>{0, 2, 0}));
+  EXPECT_TRUE(std::ranges::equal(matrix.GetCumulativeElements(), std::vector<int>{2, 3}));
+
+  // The size line has to agree with the body.
+  write("%%MatrixMarket matrix coordinate real general\n3 2 10\n1 1 2.0\n");
+  EXPECT_THROW(sparse_matrix_multiplication_omp::ReadMatrixMarket(path), std::runtime_error);
+  // Parts below the threshold count once they are summed.
+  write("%%MatrixMarket matrix coordinate real general\n2 2 3\n2 2 6e-7\n2 2 6e-7\n1 1 1e-7\n");
+  matrix = sparse_matrix_multiplication_omp::ReadMatrixMarket(path);
+  EXPECT_TRUE(std::ranges::equal(matrix.GetRowIndices(), std::vector<int>{1}));
+  EXPECT_NEAR(matrix.GetValues()[0], 1.2e-6, 1e-12);
+
+  // A missing value, a negative entry count and a count no shape could hold.
+  write("%%MatrixMarket matrix coordinate real general\n3 2 2\n1 1 2.0\n3 2");
+  EXPECT_THROW(sparse_matrix_multiplication_omp::ReadMatrixMarket(path), std::runtime_error);
+  write("%%MatrixMarket matrix coordinate real general\n3 2 -1\n1 1 2.0\n");
+  EXPECT_THROW(sparse_matrix_multiplication_omp::ReadMatrixMarket(path), std::runtime_error);
+  write("%%MatrixMarket matrix coordinate real general\n3 2 18446744073709551615\n1 1 2.0\n");
+  EXPECT_THROW(sparse_matrix_multiplication_omp::ReadMatrixMarket(path), std::runtime_error);
+  write("%%MatrixMarket matrix coordinate real general\n3 2 4000000000\n1 1 2.0\n");
+  EXPECT_THROW(sparse_matrix_multiplication_omp::ReadMatrixMarket(path), std::runtime_error);
+  write("%%MatrixMarket matrix coordinate real general\n3 2 1\n4 1 2.0\n");
+  EXPECT_THROW(sparse_matrix_multiplication_omp::ReadMatrixMarket(path), std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(sparse_matrix_multiplication_omp, test_read_matrix_market_missing_file) {
+  EXPECT_THROW(sparse_matrix_multiplication_omp::ReadMatrixMarket(
+                   ppc::util::GetAbsolutePath("omp/sparse_matrix/data/missing.mtx")),
+               std::runtime_error);
+}
+
+TEST(sparse_matrix_multiplication_omp, test_binary_ccs_mapped_task_input) {
+  const auto epsilon = 1e-6;
+
+  std::vector<double> matrixA{0, 1, 0, 6, 0, 0, 4, 3, 1, 0, 0, 2};
+  std::vector<double> matrixB{0.5, 0, 1.5, 0, 0, 8.0, 3.0, 0, 0, 7, 0, 2};
+  auto first = sparse_matrix_multiplication_omp::MatrixToSparse(3, 4, matrixA);
+  auto second = sparse_matrix_multiplication_omp::MatrixToSparse(4, 3, matrixB);
+  auto first_path = (std::filesystem::temp_directory_path() / "sparse_matrix_omp_a.ccs").string();
+  auto second_path = (std::filesystem::temp_directory_path() / "sparse_matrix_omp_b.ccs").string();
+  sparse_matrix_multiplication_omp::WriteBinaryCCS(first_path, first);
+  sparse_matrix_multiplication_omp::WriteBinaryCCS(second_path, second);
+
+  auto mapped_first = sparse_matrix_multiplication_omp::MapBinaryCCS(first_path);
+  auto mapped_second = sparse_matrix_multiplication_omp::MapBinaryCCS(second_path);
+  std::filesystem::remove(first_path);
+  std::filesystem::remove(second_path);
+  ASSERT_TRUE(std::ranges::equal(mapped_first.GetValues(), first.GetValues()));
+  ASSERT_TRUE(std::ranges::equal(mapped_second.GetRowIndices(), second.GetRowIndices()));
+
+  // The task reads the mapped pages in place; it never writes through its input pointers.
+  auto input = [](auto span) {
+    return reinterpret_cast<uint8_t*>(const_cast<void*>(static_cast<const void*>(span.data())));
+  };
+  std::vector<double> result_values(9, 0);
+  std::vector<int> result_rows(9, 0);
+  std::vector<int> result_cumulative(3, 0);
+
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs = {input(mapped_first.GetValues()), input(mapped_first.GetRowIndices()),
+                      input(mapped_first.GetCumulativeElements()), input(mapped_second.GetValues()),
+                      input(mapped_second.GetRowIndices()), input(mapped_second.GetCumulativeElements())};
+  taskData->inputs_count = {3, 4, 4, 3, static_cast<uint32_t>(mapped_first.GetValues().size()),
+                            static_cast<uint32_t>(mapped_second.GetValues().size())};
+  taskData->outputs = {reinterpret_cast<uint8_t*>(result_values.data()),
+                       reinterpret_cast<uint8_t*>(result_rows.data()),
+                       reinterpret_cast<uint8_t*>(result_cumulative.data())};
+  taskData->outputs_count = {9, 9, 3};
+
+  sparse_matrix_multiplication_omp::CCSMatrixOMP multiplicationTask(taskData);
+  ASSERT_TRUE(multiplicationTask.Validation()) << "Validation failed!";
+
+  multiplicationTask.PreProcessing();
+  multiplicationTask.Run();
+  ASSERT_TRUE(multiplicationTask.PostProcessing());
+
+  auto expected = first * second;
+  ASSERT_EQ(taskData->outputs_count[0], expected.GetValues().size());
+  for (size_t i = 0; i < expected.GetValues().size(); i++) {
+    EXPECT_NEAR(result_values[i], expected.GetValues()[i], epsilon) << "Mismatch at index " << i;
+    EXPECT_EQ(result_rows[i], expected.GetRowIndices()[i]) << "Mismatch at index " << i;
+  }
+  EXPECT_TRUE(std::ranges::equal(result_cumulative, expected.GetCumulativeElements()));
+}
+
+TEST(sparse_matrix_multiplication_omp, test_binary_ccs_wide_indices) {
+  auto dense = sparse_matrix_multiplication_omp::GenerateRandomMatrix(20 * 30);
+  auto matrix = sparse_matrix_multiplication_omp::MatrixToSparse<double, std::int64_t>(20, 30, dense);
+  auto path = (std::filesystem::temp_directory_path() / "sparse_matrix_omp_wide.ccs").string();
+  sparse_matrix_multiplication_omp::WriteBinaryCCS(path, matrix);
+
+  // The indices are mapped as they were written, so only an index type of the same width fits.
+  auto mapped = sparse_matrix_multiplication_omp::MapBinaryCCS<std::int64_t>(path);
+  EXPECT_THROW(sparse_matrix_multiplication_omp::MapBinaryCCS(path), std::runtime_error);
+  std::filesystem::remove(path);
+  EXPECT_TRUE(std::ranges::equal(mapped.GetValues(), matrix.GetValues()));
+  EXPECT_TRUE(std::ranges::equal(mapped.GetRowIndices(), matrix.GetRowIndices()));
+  EXPECT_TRUE(std::ranges::equal(mapped.GetCumulativeElements(), matrix.GetCumulativeElements()));
+  EXPECT_EQ(sparse_matrix_multiplication_omp::FromSparseMatrix(mapped), dense);
+}
+
+TEST(sparse_matrix_multiplication_omp, test_map_binary_ccs_rejects_other_files) {
+  auto dense = sparse_matrix_multiplication_omp::GenerateRandomMatrix(20 * 30);
+  auto matrix = sparse_matrix_multiplication_omp::MatrixToSparse(20, 30, dense);
+  auto path = (std::filesystem::temp_directory_path() / "sparse_matrix_omp_corrupt.ccs").string();
+  sparse_matrix_multiplication_omp::WriteBinaryCCS(path, matrix);
+  {
+    // The first row index past the 20 rows, as a corrupt file might hold it.
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    sparse_matrix_multiplication_omp::BinaryCCSHeader header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    file.seekp(static_cast<std::streamoff>(header.row_indices_offset));
+    const int row = 20;
+    file.write(reinterpret_cast<const char*>(&row), sizeof(row));
+  }
+  EXPECT_THROW(sparse_matrix_multiplication_omp::MapBinaryCCS(path), std::runtime_error);
+  std::filesystem::remove(path);
+
+  EXPECT_THROW(sparse_matrix_multiplication_omp::MapBinaryCCS(
+                   ppc::util::GetAbsolutePath("omp/sparse_matrix/data/grid_4x4.mtx")),
+               std::runtime_error);
+  EXPECT_THROW(sparse_matrix_multiplication_omp::MapBinaryCCS(
+                   ppc::util::GetAbsolutePath("omp/sparse_matrix/data/missing.ccs")),
+               std::runtime_error);
+}
+
 TEST(sparse_matrix_multiplication_omp, test_matrices_200) {
   const auto size = 200;
 
@@ -1,64 +1,135 @@
 #pragma once
 
-#include <omp.h>
-
-#include <iostream>
-#include <utility>
+#include <cstdint>
+#include <string>
 #include <vector>
 
-#include "core/task/include/task.hpp"
+#include "sparse/matrix/include/binary_ccs.hpp"
+#include "sparse/matrix/include/block_sparse_matrix.hpp"
+#include "sparse/matrix/include/csr_matrix.hpp"
+#include "sparse/matrix/include/execution_omp.hpp"
+#include "sparse/matrix/include/generators.hpp"
+#include "sparse/matrix/include/matrix_market.hpp"
+#include "sparse/matrix/include/sparse_chain.hpp"
+#include "sparse/matrix/include/sparse_dot.hpp"
+#include "sparse/matrix/include/sparse_matrix.hpp"
+#include "sparse/task/include/ccs_matrix_task.hpp"
+#include "sparse/task/include/chain_task.hpp"
 
-namespace sparse_matrix_multiplication_omp {
+// Compiled once for this policy in sparse_matrix_omp.cpp.
+extern template class ppc::sparse::BasicSparseMatrix<float, int, ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::BasicSparseMatrix<float, std::int64_t, ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::BasicSparseMatrix<double, int, ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::BasicSparseMatrix<double, std::int64_t, ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::BasicSpGEMMPlan<float, int, ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::BasicSpGEMMPlan<float, std::int64_t, ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::BasicSpGEMMPlan<double, int, ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::BasicSpGEMMPlan<double, std::int64_t, ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::BasicBlockSparseMatrix<float, int, ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::BasicBlockSparseMatrix<float, std::int64_t, ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::BasicBlockSparseMatrix<double, int, ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::BasicBlockSparseMatrix<double, std::int64_t, ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::BasicCsrMatrix<float, int, ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::BasicCsrMatrix<float, std::int64_t, ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::BasicCsrMatrix<double, int, ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::BasicCsrMatrix<double, std::int64_t, ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::BasicChainPlan<float, int, ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::BasicChainPlan<float, std::int64_t, ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::BasicChainPlan<double, int, ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::BasicChainPlan<double, std::int64_t, ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::CCSMatrixTask<ppc::sparse::OmpPolicy>;
+extern template class ppc::sparse::ChainProductTask<ppc::sparse::OmpPolicy>;
 
-const int chunk_size = 1;
-std::vector<double> GenerateRandomMatrix(int dimension);
-std::vector<double> MultiplyMatrices(const std::vector<double>& first_matrix, int first_rows, int first_columns,
-                                     const std::vector<double>& second_matrix, int second_rows, int second_columns);
+namespace sparse_matrix_multiplication_omp {
 
-class SparseMatrix {
-  int rows_count_ = 0;
-  int cols_count_ = 0;
-  std::vector<double> values_;
-  std::vector<int> row_indices_;
-  std::vector<int> cumulative_elements_;
+// The modules/sparse library with every kernel running under OpenMP. The types and functions below fix the
+// policy and keep the names the tests and the other tasks use; their documentation lives with the library.
+using Policy = ppc::sparse::OmpPolicy;
 
-  static SparseMatrix ComputeTranspose(const SparseMatrix& matrix);
-  static int CountElements(int index, const std::vector<int>& elements_count);
+template <typename Value, typename Index>
+using BasicSparseMatrix = ppc::sparse::BasicSparseMatrix<Value, Index, Policy>;
+template <typename Value, typename Index>
+using BasicSpGEMMPlan = ppc::sparse::BasicSpGEMMPlan<Value, Index, Policy>;
+template <typename Value, typename Index>
+using BasicBlockSparseMatrix = ppc::sparse::BasicBlockSparseMatrix<Value, Index, Policy>;
+template <typename Value, typename Index>
+using BasicCsrMatrix = ppc::sparse::BasicCsrMatrix<Value, Index, Policy>;
+template <typename Value, typename Index>
+using BasicChainPlan = ppc::sparse::BasicChainPlan<Value, Index, Policy>;
+using SparseMatrix = BasicSparseMatrix<double, int>;
+using SpGEMMPlan = BasicSpGEMMPlan<double, int>;
+using BlockSparseMatrix = BasicBlockSparseMatrix<double, int>;
+using CsrMatrix = BasicCsrMatrix<double, int>;
+using ChainPlan = BasicChainPlan<double, int>;
 
-  SparseMatrix MatrixToSparse(int rows_count, int columns_count, const std::vector<double>& values);
-  std::vector<double> FromSparseMatrix(const SparseMatrix& matrix);
+using ppc::sparse::BinaryCCSHeader;
+using ppc::sparse::ChainStep;
+using ppc::sparse::DropPolicy;
+using ppc::sparse::FromCsrMatrix;
+using ppc::sparse::FromSparseMatrix;
+using ppc::sparse::GenerateRandomMatrix;
+using ppc::sparse::kBlocksPerThread;
+using ppc::sparse::MultiplyMatrices;
+using ppc::sparse::MultiplyStats;
+using ppc::sparse::NeedsWideIndices;
+using ppc::sparse::PartitionColumns;
+using ppc::sparse::SparseDot;
+using ppc::sparse::SparseDotKernel;
+using ppc::sparse::SparseLayout;
+using ppc::sparse::WriteBinaryCCS;
+using ppc::sparse::WriteMatrixMarket;
 
- public:
-  constexpr static double kThreshold = 1e-6;
-  SparseMatrix() = default;
-  SparseMatrix(int rows, int columns, const std::vector<double>& values, const std::vector<int>& rows_index,
-               const std::vector<int>& cumulative_sum) noexcept
-      : rows_count_(rows),
-        cols_count_(columns),
-        values_(values),
-        row_indices_(rows_index),
-        cumulative_elements_(cumulative_sum) {}
+template <typename Value, typename Index = int>
+BasicSparseMatrix<Value, Index> MatrixToSparse(int rows_count, int columns_count, const Value* values) {
+  return ppc::sparse::MatrixToSparse<Value, Index, Policy>(rows_count, columns_count, values);
+}
+template <typename Value, typename Index = int>
+BasicSparseMatrix<Value, Index> MatrixToSparse(int rows_count, int columns_count, const std::vector<Value>& values) {
+  return ppc::sparse::MatrixToSparse<Value, Index, Policy>(rows_count, columns_count, values);
+}
 
-  const std::vector<double>& GetValues() const noexcept { return values_; }
-  const std::vector<int>& GetRowIndices() const noexcept { return row_indices_; }
-  const std::vector<int>& GetCumulativeElements() const noexcept { return cumulative_elements_; }
-  int GetColumnCount() const noexcept { return cols_count_; }
-  int GetRowCount() const noexcept { return rows_count_; }
+template <typename Value, typename Index = int>
+BasicCsrMatrix<Value, Index> MatrixToCsr(int rows_count, int columns_count, const Value* values) {
+  return ppc::sparse::MatrixToCsr<Value, Index, Policy>(rows_count, columns_count, values);
+}
+template <typename Value, typename Index = int>
+BasicCsrMatrix<Value, Index> MatrixToCsr(int rows_count, int columns_count, const std::vector<Value>& values) {
+  return ppc::sparse::MatrixToCsr<Value, Index, Policy>(rows_count, columns_count, values);
+}
 
-  SparseMatrix operator*(const SparseMatrix& other) const noexcept(false);
-};
+template <typename Value = double, typename Index = int>
+BasicSparseMatrix<Value, Index> GenerateUniform(int rows_count, int columns_count, double density,
+                                                std::uint64_t seed) {
+  return ppc::sparse::GenerateUniform<Value, Index, Policy>(rows_count, columns_count, density, seed);
+}
+template <typename Value = double, typename Index = int>
+BasicSparseMatrix<Value, Index> GenerateBanded(int size, int lower, int upper, double density, std::uint64_t seed) {
+  return ppc::sparse::GenerateBanded<Value, Index, Policy>(size, lower, upper, density, seed);
+}
+template <typename Value = double, typename Index = int>
+BasicSparseMatrix<Value, Index> GenerateBlockDiagonal(int size, int block_size, double density, std::uint64_t seed) {
+  return ppc::sparse::GenerateBlockDiagonal<Value, Index, Policy>(size, block_size, density, seed);
+}
+template <typename Value = double, typename Index = int>
+BasicSparseMatrix<Value, Index> GenerateRMat(int scale, double density, std::uint64_t seed, double a = 0.57,
+                                             double b = 0.19, double c = 0.19) {
+  return ppc::sparse::GenerateRMat<Value, Index, Policy>(scale, density, seed, a, b, c);
+}
 
-class CCSMatrixOMP : public ppc::core::Task {
-  SparseMatrix first_matrix_;
-  SparseMatrix second_matrix_;
-  SparseMatrix result_matrix_;
+inline SparseMatrix ReadMatrixMarket(const std::string& path) { return ppc::sparse::ReadMatrixMarket<Policy>(path); }
+template <typename Index = int>
+BasicSparseMatrix<double, Index> MapBinaryCCS(const std::string& path) {
+  return BasicSparseMatrix<double, Index>(ppc::sparse::MapBinaryCCS<Index>(path));
+}
 
+class CCSMatrixOMP final : public ppc::sparse::CCSMatrixTask<Policy> {
  public:
-  explicit CCSMatrixOMP(ppc::core::TaskDataPtr task_data) : Task(std::move(task_data)) {}
+  using CCSMatrixTask::CCSMatrixTask;
+};
 
-  bool PreProcessingImpl() override;
-  bool ValidationImpl() override;
-  bool RunImpl() override;
-  bool PostProcessingImpl() override;
+class CCSChainOMP final : public ppc::sparse::ChainProductTask<Policy> {
+ public:
+  using ChainProductTask::ChainProductTask;
 };
-}  // namespace sparse_matrix_multiplication_omp
\ No newline at end of file
+
+}  // namespace sparse_matrix_multiplication_omp
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+#include "omp/sparse_matrix/include/sparse_matrix_omp.hpp"
+#include "omp/sparse_matrix_vector/include/spmv_omp.hpp"
+
+TEST(sparse_matrix_vector_multiplication_omp, test_layouts_match_dense) {
+  const int rows = 37;
+  const int cols = 53;
+  auto dense = sparse_matrix_multiplication_omp::GenerateRandomMatrix(rows * cols);
+  // An empty row and an empty column on top of the random pattern.
+  for (int col = 0; col < cols; col++) dense[(5 * cols) + col] = 0;
+  for (int row = 0; row < rows; row++) dense[(row * cols) + 11] = 0;
+  auto matrix = sparse_matrix_multiplication_omp::MatrixToSparse(rows, cols, dense);
+  auto transposed = sparse_matrix_multiplication_omp::SparseMatrix::ComputeTranspose(matrix);
+
+  // Single vectors, a ragged block, an exact register block and a block with a tail.
+  for (int vectors : {1, 3, 8, 13}) {
+    auto block = sparse_matrix_multiplication_omp::GenerateRandomMatrix(cols * vectors);
+    auto expected = sparse_matrix_multiplication_omp::MultiplyMatrices(dense, rows, cols, block, cols, vectors);
+
+    std::vector<double> ccs(rows * vectors, -1);
+    sparse_matrix_vector_multiplication_omp::MultiplyCcs(matrix, block.data(), vectors, ccs.data());
+    EXPECT_EQ(ccs, expected) << vectors << " vectors";
+
+    std::vector<double> csr(rows * vectors, -1);
+    sparse_matrix_vector_multiplication_omp::MultiplyCsr(transposed, block.data(), vectors, csr.data());
+    EXPECT_EQ(csr, expected) << vectors << " vectors";
+  }
+}
+
+TEST(sparse_matrix_vector_multiplication_omp, test_float_and_wide_indices) {
+  // Row 1 of A is empty, so row 1 of Y must come out zero rather than keep what the buffer held.
+  std::vector<float> dense{0, 1, 0, 6, 0, 0, 0, 0, 4, 3, 1, 2};
+  std::vector<float> block{1, 2, 3, 4, 5, 6, 7, 8};
+  std::vector<float> expected{45, 52, 0, 0, 32, 42};
+
+  auto matrix = sparse_matrix_multiplication_omp::MatrixToSparse<float, std::int64_t>(3, 4, dense);
+  auto transposed = sparse_matrix_multiplication_omp::BasicSparseMatrix<float, std::int64_t>::ComputeTranspose(matrix);
+  std::vector<float> ccs(6, -1);
+  std::vector<float> csr(6, -1);
+  sparse_matrix_vector_multiplication_omp::MultiplyCcs(matrix, block.data(), 2, ccs.data());
+  sparse_matrix_vector_multiplication_omp::MultiplyCsr(transposed, block.data(), 2, csr.data());
+  EXPECT_EQ(ccs, expected);
+  EXPECT_EQ(csr, expected);
+}
+
+TEST(sparse_matrix_vector_multiplication_omp, test_task_layouts) {
+  const int rows = 20;
+  const int cols = 30;
+  const int vectors = 4;
+  auto dense = sparse_matrix_multiplication_omp::GenerateRandomMatrix(rows * cols);
+  auto block = sparse_matrix_multiplication_omp::GenerateRandomMatrix(cols * vectors);
+  auto expected = sparse_matrix_multiplication_omp::MultiplyMatrices(dense, rows, cols, block, cols, vectors);
+  auto matrix = sparse_matrix_multiplication_omp::MatrixToSparse(rows, cols, dense);
+  std::vector<double> values(matrix.GetValues().begin(), matrix.GetValues().end());
+  std::vector<int> row_indices(matrix.GetRowIndices().begin(), matrix.GetRowIndices().end());
+  std::vector<int> cumulative(matrix.GetCumulativeElements().begin(), matrix.GetCumulativeElements().end());
+
+  for (auto layout : {sparse_matrix_vector_multiplication_omp::SparseLayout::kCcs,
+                      sparse_matrix_vector_multiplication_omp::SparseLayout::kCsr}) {
+    std::vector<double> result(rows * vectors, -1);
+    auto taskData = std::make_shared<ppc::core::TaskData>();
+    taskData->inputs = {reinterpret_cast<uint8_t*>(values.data()), reinterpret_cast<uint8_t*>(row_indices.data()),
+                        reinterpret_cast<uint8_t*>(cumulative.data()), reinterpret_cast<uint8_t*>(block.data())};
+    taskData->inputs_count = {rows, cols, static_cast<uint32_t>(values.size()), vectors};
+    taskData->outputs.push_back(reinterpret_cast<uint8_t*>(result.data()));
+    taskData->outputs_count.push_back(result.size());
+
+    sparse_matrix_vector_multiplication_omp::SpMMOMP task(taskData, layout);
+    ASSERT_TRUE(task.Validation());
+    task.PreProcessing();
+    task.Run();
+    task.PostProcessing();
+    EXPECT_EQ(result, expected);
+  }
+}
+
+TEST(sparse_matrix_vector_multiplication_omp, test_task_validation) {
+  std::vector<double> values{1};
+  std::vector<int> row_indices{0};
+  std::vector<int> cumulative{1};
+  std::vector<double> block{2};
+  std::vector<double> result(1, 0);
+
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs = {reinterpret_cast<uint8_t*>(values.data()), reinterpret_cast<uint8_t*>(row_indices.data()),
+                      reinterpret_cast<uint8_t*>(cumulative.data())};
+  taskData->inputs_count = {1, 1, 1, 1};
+  taskData->outputs.push_back(reinterpret_cast<uint8_t*>(result.data()));
+  taskData->outputs_count.push_back(result.size());
+  // No right-hand side block.
+  EXPECT_FALSE(sparse_matrix_vector_multiplication_omp::SpMMOMP(taskData).Validation());
+
+  taskData->inputs.push_back(reinterpret_cast<uint8_t*>(block.data()));
+  taskData->inputs_count[3] = 0;
+  EXPECT_FALSE(sparse_matrix_vector_multiplication_omp::SpMMOMP(taskData).Validation());
+
+  taskData->inputs_count[3] = 1;
+  EXPECT_TRUE(sparse_matrix_vector_multiplication_omp::SpMMOMP(taskData).Validation());
+
+  // Y has room for a_rows x vectors doubles, no more and no less.
+  taskData->outputs_count[0] = 2;
+  EXPECT_FALSE(sparse_matrix_vector_multiplication_omp::SpMMOMP(taskData).Validation());
+  taskData->outputs_count[0] = 1;
+  // A has no rows.
+  taskData->inputs_count[0] = 0;
+  EXPECT_FALSE(sparse_matrix_vector_multiplication_omp::SpMMOMP(taskData).Validation());
+  taskData->inputs_count[0] = 1;
+  // The counts end short of the declared nnz.
+  taskData->inputs_count[2] = 2;
+  EXPECT_FALSE(sparse_matrix_vector_multiplication_omp::SpMMOMP(taskData).Validation());
+  taskData->inputs_count[2] = 1;
+  // A row index past the row count.
+  row_indices[0] = 1;
+  EXPECT_FALSE(sparse_matrix_vector_multiplication_omp::SpMMOMP(taskData).Validation());
+}
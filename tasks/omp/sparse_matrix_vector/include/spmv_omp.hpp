@@ -0,0 +1,24 @@
+#pragma once
+
+#include "omp/sparse_matrix/include/sparse_matrix_omp.hpp"
+#include "sparse/task/include/spmm_task.hpp"
+
+// Compiled once for this policy in spmv_omp.cpp.
+extern template class ppc::sparse::SpMMTask<ppc::sparse::OmpPolicy>;
+
+namespace sparse_matrix_vector_multiplication_omp {
+
+using sparse_matrix_multiplication_omp::BasicSparseMatrix;
+using sparse_matrix_multiplication_omp::Policy;
+
+using ppc::sparse::kVectorBlock;
+using ppc::sparse::MultiplyCcs;
+using ppc::sparse::MultiplyCsr;
+using ppc::sparse::SparseLayout;
+
+class SpMMOMP final : public ppc::sparse::SpMMTask<Policy> {
+ public:
+  using SpMMTask::SpMMTask;
+};
+
+}  // namespace sparse_matrix_vector_multiplication_omp
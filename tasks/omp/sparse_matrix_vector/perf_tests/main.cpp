@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+#include "core/task/include/task.hpp"
+#include "omp/sparse_matrix/include/sparse_matrix_omp.hpp"
+#include "omp/sparse_matrix_vector/include/spmv_omp.hpp"
+#include "sparse/task/include/kernel_task.hpp"
+
+namespace {
+
+// Square matrix with per_column random entries in every column, the shape of a discretised operator.
+sparse_matrix_multiplication_omp::SparseMatrix GenerateOperator(int size, int per_column) {
+  std::mt19937 generator(17);
+  std::uniform_int_distribution<int> row(0, size - 1);
+  std::vector<double> values;
+  std::vector<int> row_indices;
+  std::vector<int> cumulative;
+  std::vector<int> column;
+  for (int col = 0; col < size; col++) {
+    column.clear();
+    for (int e = 0; e < per_column; e++) column.push_back(row(generator));
+    std::ranges::sort(column);
+    column.erase(std::ranges::unique(column).begin(), column.end());
+    for (int r : column) {
+      row_indices.push_back(r);
+      values.push_back(1.0 / (1 + (r % 7)));
+    }
+    cumulative.push_back(static_cast<int>(row_indices.size()));
+  }
+  return {size, size, std::move(values), std::move(row_indices), std::move(cumulative)};
+}
+
+double Seconds(std::chrono::high_resolution_clock::time_point begin,
+               std::chrono::high_resolution_clock::time_point end) {
+  return std::chrono::duration<double>(end - begin).count();
+}
+
+// Times Run of a layout task on Y = A * X for a million-row operator with 12 entries per column and 8 vectors.
+void MeasureLayout(sparse_matrix_vector_multiplication_omp::SparseLayout layout) {
+  const int size = 1000000;
+  const int vectors = 8;
+  auto matrix = GenerateOperator(size, 12);
+  std::vector<double> values(matrix.GetValues().begin(), matrix.GetValues().end());
+  std::vector<int> row_indices(matrix.GetRowIndices().begin(), matrix.GetRowIndices().end());
+  std::vector<int> cumulative(matrix.GetCumulativeElements().begin(), matrix.GetCumulativeElements().end());
+  std::vector<double> block(static_cast<size_t>(size) * vectors, 1);
+  std::vector<double> result(static_cast<size_t>(size) * vectors, 0);
+
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs = {reinterpret_cast<uint8_t*>(values.data()), reinterpret_cast<uint8_t*>(row_indices.data()),
+                       reinterpret_cast<uint8_t*>(cumulative.data()), reinterpret_cast<uint8_t*>(block.data())};
+  task_data->inputs_count = {size, size, static_cast<uint32_t>(values.size()), vectors};
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(result.data()));
+  task_data->outputs_count.emplace_back(result.size());
+
+  ppc::sparse::MeasurePerf(std::make_shared<sparse_matrix_vector_multiplication_omp::SpMMOMP>(task_data, layout), 5);
+}
+
+}  // namespace
+
+TEST(sparse_matrix_vector_multiplication_omp, test_pipeline_run) {
+  const int size = 200000;
+  const int vectors = 8;
+  auto matrix = GenerateOperator(size, 16);
+  std::vector<double> values(matrix.GetValues().begin(), matrix.GetValues().end());
+  std::vector<int> row_indices(matrix.GetRowIndices().begin(), matrix.GetRowIndices().end());
+  std::vector<int> cumulative(matrix.GetCumulativeElements().begin(), matrix.GetCumulativeElements().end());
+  std::vector<double> block(static_cast<size_t>(size) * vectors, 1);
+  std::vector<double> result(static_cast<size_t>(size) * vectors, 0);
+
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs = {reinterpret_cast<uint8_t*>(values.data()), reinterpret_cast<uint8_t*>(row_indices.data()),
+                       reinterpret_cast<uint8_t*>(cumulative.data()), reinterpret_cast<uint8_t*>(block.data())};
+  task_data->inputs_count = {size, size, static_cast<uint32_t>(values.size()), vectors};
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(result.data()));
+  task_data->outputs_count.emplace_back(result.size());
+
+  auto task = std::make_shared<sparse_matrix_vector_multiplication_omp::SpMMOMP>(task_data);
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 10;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perf_attr->current_timer = [&] { return Seconds(t0, std::chrono::high_resolution_clock::now()); };
+
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+  auto perf_analyzer = std::make_shared<ppc::core::Perf>(task);
+  perf_analyzer->PipelineRun(perf_attr, perf_results);
+  ppc::core::Perf::PrintPerfStatistic(perf_results);
+
+  // With X all ones, every entry of Y is the sum of its row of A.
+  auto transposed = sparse_matrix_multiplication_omp::SparseMatrix::ComputeTranspose(matrix);
+  auto sums = transposed.GetCumulativeElements();
+  for (int row = 0; row < size; row += 997) {
+    double expected = 0;
+    for (int e = row == 0 ? 0 : sums[row - 1]; e < sums[row]; e++) expected += transposed.GetValues()[e];
+    EXPECT_NEAR(result[static_cast<size_t>(row) * vectors], expected, 1e-9);
+  }
+}
+
+TEST(sparse_matrix_vector_multiplication_omp, test_task_run) {
+  const int size = 200000;
+  const int vectors = 1;
+  auto matrix = GenerateOperator(size, 16);
+  std::vector<double> values(matrix.GetValues().begin(), matrix.GetValues().end());
+  std::vector<int> row_indices(matrix.GetRowIndices().begin(), matrix.GetRowIndices().end());
+  std::vector<int> cumulative(matrix.GetCumulativeElements().begin(), matrix.GetCumulativeElements().end());
+  std::vector<double> block(static_cast<size_t>(size) * vectors, 1);
+  std::vector<double> result(static_cast<size_t>(size) * vectors, 0);
+
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs = {reinterpret_cast<uint8_t*>(values.data()), reinterpret_cast<uint8_t*>(row_indices.data()),
+                       reinterpret_cast<uint8_t*>(cumulative.data()), reinterpret_cast<uint8_t*>(block.data())};
+  task_data->inputs_count = {size, size, static_cast<uint32_t>(values.size()), vectors};
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(result.data()));
+  task_data->outputs_count.emplace_back(result.size());
+
+  auto task = std::make_shared<sparse_matrix_vector_multiplication_omp::SpMMOMP>(task_data);
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 10;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perf_attr->current_timer = [&] { return Seconds(t0, std::chrono::high_resolution_clock::now()); };
+
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+  auto perf_analyzer = std::make_shared<ppc::core::Perf>(task);
+  perf_analyzer->TaskRun(perf_attr, perf_results);
+  ppc::core::Perf::PrintPerfStatistic(perf_results);
+
+  double total = 0;
+  for (double value : result) total += value;
+  double expected = 0;
+  for (double value : values) expected += value;
+  EXPECT_NEAR(total, expected, 1e-6 * expected);
+}
+
+TEST(sparse_matrix_vector_multiplication_omp, test_triad_run) {
+  // STREAM triad over arrays of as many doubles as A in test_ccs_layout_run has entries, as the attainable
+  // bandwidth to hold the layouts against.
+  const size_t triad_size = GenerateOperator(1000000, 12).GetValues().size();
+  std::vector<double> a(triad_size, 0);
+  std::vector<double> b(triad_size, 1);
+  std::vector<double> c(triad_size, 2);
+
+  ppc::sparse::MeasureKernel(
+      [&] {
+        for (size_t i = 0; i < triad_size; i++) a[i] = b[i] + (3 * c[i]);
+      },
+      10);
+}
+
+TEST(sparse_matrix_vector_multiplication_omp, test_ccs_layout_run) {
+  MeasureLayout(sparse_matrix_vector_multiplication_omp::SparseLayout::kCcs);
+}
+
+TEST(sparse_matrix_vector_multiplication_omp, test_csr_layout_run) {
+  MeasureLayout(sparse_matrix_vector_multiplication_omp::SparseLayout::kCsr);
+}
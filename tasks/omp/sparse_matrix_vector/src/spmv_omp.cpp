@@ -0,0 +1,3 @@
+#include "omp/sparse_matrix_vector/include/spmv_omp.hpp"
+
+template class ppc::sparse::SpMMTask<ppc::sparse::OmpPolicy>;
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "seq/sparse_matrix/include/sparse_matrix_seq.hpp"
+#include "sparse/task/include/spmm_task.hpp"
+
+// Compiled once for this policy in spmv_seq.cpp.
+extern template class ppc::sparse::SpMMTask<ppc::sparse::SequentialPolicy>;
+
+namespace sparse_matrix_vector_multiplication_seq {
+
+using sparse_matrix_multiplication_seq::BasicSparseMatrix;
+using sparse_matrix_multiplication_seq::Policy;
+
+using ppc::sparse::kVectorBlock;
+using ppc::sparse::MultiplyCcs;
+using ppc::sparse::MultiplyCsr;
+using ppc::sparse::SparseLayout;
+
+class SpMMSeq final : public ppc::sparse::SpMMTask<Policy> {
+ public:
+  using SpMMTask::SpMMTask;
+};
+
+}  // namespace sparse_matrix_vector_multiplication_seq
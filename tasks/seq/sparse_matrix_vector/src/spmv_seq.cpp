@@ -0,0 +1,3 @@
+#include "seq/sparse_matrix_vector/include/spmv_seq.hpp"
+
+template class ppc::sparse::SpMMTask<ppc::sparse::SequentialPolicy>;
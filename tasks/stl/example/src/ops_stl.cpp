@@ -2,14 +2,13 @@
 
 #include <cmath>
 #include <cstddef>
-#include <thread>
 #include <vector>
 
-#include "core/util/include/util.hpp"
+#include "core/util/include/thread_pool.hpp"
 
 namespace {
-void MatMul(const std::vector<int> &in_vec, int rc_size, std::vector<int> &out_vec) {
-  for (int i = 0; i < rc_size; ++i) {
+void MatMul(const std::vector<int> &in_vec, int rc_size, int first_row, int last_row, std::vector<int> &out_vec) {
+  for (int i = first_row; i < last_row; ++i) {
     for (int j = 0; j < rc_size; ++j) {
       out_vec[(i * rc_size) + j] = 0;
       for (int k = 0; k < rc_size; ++k) {
@@ -39,12 +38,11 @@ bool nesterov_a_test_task_stl::TestTaskSTL::ValidationImpl() {
 }
 
 bool nesterov_a_test_task_stl::TestTaskSTL::RunImpl() {
-  const int num_threads = ppc::util::GetPPCNumThreads();
-  std::vector<std::thread> threads(num_threads);
-  for (int i = 0; i < num_threads; i++) {
-    threads[i] = std::thread(MatMul, std::cref(input_), rc_size_, std::ref(output_));
-    threads[i].join();
-  }
+  auto &pool = ppc::util::ThreadPool::Shared();
+  const int num_threads = pool.GetThreadsCount();
+  pool.ParallelFor(num_threads, [&](int i) {
+    MatMul(input_, rc_size_, rc_size_ * i / num_threads, rc_size_ * (i + 1) / num_threads, output_);
+  });
   return true;
 }
 
@@ -1,8 +1,17 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
 #include "core/perf/include/perf.hpp"
 #include "core/task/include/task.hpp"
 #include "stl/sparse_matrix/include/sparse_matrix_stl.hpp"
+#include "sparse/task/include/kernel_task.hpp"
 
 TEST(sparse_matrix_multiplication_stl, test_pipeline_run) {
   const auto epsilon = 1e-6;
@@ -68,4 +77,378 @@ TEST(sparse_matrix_multiplication_stl, test_task_run) {
   perf_analyzer->TaskRun(perf_attr, perf_results);
   ppc::core::Perf::PrintPerfStatistic(perf_results);
   for (auto i = 0; i < static_cast<int>(result.size()); i++) EXPECT_NEAR(result[i], expectedOutput[i], epsilon);
-}
\ No newline at end of file
+}
+
+namespace {
+
+// size x size matrix of GenerateRandomMatrix, as CCS.
+sparse_matrix_multiplication_stl::SparseMatrix RandomSparse(int size) {
+  return sparse_matrix_multiplication_stl::MatrixToSparse(
+      size, size, sparse_matrix_multiplication_stl::GenerateRandomMatrix(size * size));
+}
+
+// An FEM-style operator on nodes nodes: every node couples to the nodes next to it on a band and to two random
+// ones, and every coupling is a dense block over the block_size unknowns of the two nodes.
+sparse_matrix_multiplication_stl::SparseMatrix BlockOperator(int nodes, int block_size) {
+  std::mt19937 generator(18);
+  std::vector<double> values;
+  std::vector<int> row_indices;
+  std::vector<int> cumulative;
+  std::vector<int> neighbours;
+  for (int node = 0; node < nodes; node++) {
+    neighbours.clear();
+    for (int other = std::max(0, node - 2); other <= std::min(nodes - 1, node + 2); other++) {
+      neighbours.push_back(other);
+    }
+    neighbours.push_back(static_cast<int>(generator() % nodes));
+    neighbours.push_back(static_cast<int>(generator() % nodes));
+    std::ranges::sort(neighbours);
+    neighbours.erase(std::ranges::unique(neighbours).begin(), neighbours.end());
+    for (int col = 0; col < block_size; col++) {
+      for (int other : neighbours) {
+        for (int row = other * block_size; row < (other + 1) * block_size; row++) {
+          row_indices.push_back(row);
+          values.push_back(static_cast<double>(generator() % 9) + 1);
+        }
+      }
+      cumulative.push_back(static_cast<int>(row_indices.size()));
+    }
+  }
+  int size = nodes * block_size;
+  return {size, size, std::move(values), std::move(row_indices), std::move(cumulative)};
+}
+
+// A 1000 x 1000 product whose first 16 columns of B are dense while the rest hold a single entry, so almost all
+// products sit in a few columns.
+std::vector<sparse_matrix_multiplication_stl::SparseMatrix> SkewedOperands() {
+  const int size = 1000;
+  const int heavy_columns = 16;
+  auto matrixA = sparse_matrix_multiplication_stl::GenerateRandomMatrix(size * size);
+  std::vector<double> matrixB(size * size, 0);
+  for (int row = 0; row < size; row++) {
+    for (int col = 0; col < heavy_columns; col++) matrixB[(row * size) + col] = 1 + ((row + col) % 7);
+  }
+  for (int col = heavy_columns; col < size; col++) matrixB[(col * size) + col] = 2;
+  return {sparse_matrix_multiplication_stl::MatrixToSparse(size, size, matrixA),
+          sparse_matrix_multiplication_stl::MatrixToSparse(size, size, matrixB)};
+}
+
+// rows_count x columns_count with up to per_column random entries in every column, values in [1, 9].
+sparse_matrix_multiplication_stl::SparseMatrix RandomColumns(int rows_count, int columns_count, int per_column,
+                                                             std::mt19937& generator) {
+  std::vector<double> values;
+  std::vector<int> row_indices;
+  std::vector<int> cumulative;
+  std::vector<int> column;
+  for (int col = 0; col < columns_count; col++) {
+    column.clear();
+    for (int e = 0; e < per_column; e++) column.push_back(static_cast<int>(generator() % rows_count));
+    std::ranges::sort(column);
+    column.erase(std::ranges::unique(column).begin(), column.end());
+    for (int row : column) {
+      row_indices.push_back(row);
+      values.push_back(static_cast<double>(generator() % 9) + 1);
+    }
+    cumulative.push_back(static_cast<int>(row_indices.size()));
+  }
+  return {rows_count, columns_count, std::move(values), std::move(row_indices), std::move(cumulative)};
+}
+
+// R, A and P of the Galerkin product R * A * P for a banded A on size points and the aggregation P that sums every
+// 4 consecutive fine points, with R = P^T.
+std::vector<sparse_matrix_multiplication_stl::SparseMatrix> GalerkinOperands(int size) {
+  const int aggregate = 4;
+  std::vector<int> aggregates(size);
+  std::iota(aggregates.begin(), aggregates.end(), 0);
+  std::vector<int> cumulative(size / aggregate);
+  for (size_t i = 0; i < cumulative.size(); i++) cumulative[i] = static_cast<int>((i + 1) * aggregate);
+  sparse_matrix_multiplication_stl::SparseMatrix prolongation(size, size / aggregate, std::vector<double>(size, 1.0),
+                                                              aggregates, cumulative);
+  return {sparse_matrix_multiplication_stl::SparseMatrix::ComputeTranspose(prolongation),
+          sparse_matrix_multiplication_stl::GenerateBanded(size, 4, 4, 0.8, 29), prolongation};
+}
+
+}  // namespace
+
+TEST(sparse_matrix_multiplication_stl, test_plan_cold_run) {
+  auto first = RandomSparse(300);
+  auto second = RandomSparse(300);
+
+  sparse_matrix_multiplication_stl::SparseMatrix product;
+  ppc::sparse::MeasureKernel(
+      [&] { product = sparse_matrix_multiplication_stl::SpGEMMPlan(first, second).Multiply(first, second); }, 10);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_plan_warm_run) {
+  auto first = RandomSparse(300);
+  auto second = RandomSparse(300);
+  sparse_matrix_multiplication_stl::SpGEMMPlan plan(first, second);
+
+  sparse_matrix_multiplication_stl::SparseMatrix product;
+  ppc::sparse::MeasureKernel([&] { product = plan.Multiply(first, second); }, 10);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_transpose_run) {
+  auto matrix = RandomSparse(1500);
+
+  sparse_matrix_multiplication_stl::SparseMatrix transposed;
+  ppc::sparse::MeasureKernel(
+      [&] { transposed = sparse_matrix_multiplication_stl::SparseMatrix::ComputeTranspose(matrix); }, 10);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_index_width_narrow_run) {
+  auto first = RandomSparse(600);
+  auto second = RandomSparse(600);
+
+  sparse_matrix_multiplication_stl::SparseMatrix product;
+  ppc::sparse::MeasureKernel([&] { product = first * second; }, 5);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_index_width_wide_run) {
+  const auto size = 600;
+  auto first = sparse_matrix_multiplication_stl::MatrixToSparse<double, std::int64_t>(
+      size, size, sparse_matrix_multiplication_stl::GenerateRandomMatrix(size * size));
+  auto second = sparse_matrix_multiplication_stl::MatrixToSparse<double, std::int64_t>(
+      size, size, sparse_matrix_multiplication_stl::GenerateRandomMatrix(size * size));
+
+  sparse_matrix_multiplication_stl::BasicSparseMatrix<double, std::int64_t> product;
+  ppc::sparse::MeasureKernel([&] { product = first * second; }, 5);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_precision_float_run) {
+  // test_index_width_narrow_run is the double product at the same size.
+  const auto size = 600;
+  auto first = sparse_matrix_multiplication_stl::MatrixToSparse(
+      size, size, sparse_matrix_multiplication_stl::GenerateRandomMatrix<float>(size * size));
+  auto second = sparse_matrix_multiplication_stl::MatrixToSparse(
+      size, size, sparse_matrix_multiplication_stl::GenerateRandomMatrix<float>(size * size));
+
+  sparse_matrix_multiplication_stl::BasicSparseMatrix<float, int> product;
+  ppc::sparse::MeasureKernel([&] { product = first * second; }, 5);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_precision_mixed_run) {
+  const auto size = 600;
+  auto first = sparse_matrix_multiplication_stl::MatrixToSparse(
+      size, size, sparse_matrix_multiplication_stl::GenerateRandomMatrix<float>(size * size));
+  auto second = sparse_matrix_multiplication_stl::MatrixToSparse(
+      size, size, sparse_matrix_multiplication_stl::GenerateRandomMatrix<float>(size * size));
+
+  // float operands and result, accumulated in double.
+  sparse_matrix_multiplication_stl::BasicSparseMatrix<float, int> product;
+  ppc::sparse::MeasureKernel([&] { product = first.Multiply<double>(second); }, 5);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_skewed_columns_run) {
+  auto operands = SkewedOperands();
+
+  sparse_matrix_multiplication_stl::SparseMatrix product;
+  ppc::sparse::MeasureKernel([&] { product = operands[0] * operands[1]; }, 5);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_inner_product_run) {
+  // A Gram-style product: a small output from long sparse vectors, one dot per entry of C.
+  std::mt19937 generator(15);
+  auto first = sparse_matrix_multiplication_stl::SparseMatrix::ComputeTranspose(
+      RandomColumns(200000, 64, 2000, generator));
+  auto second = RandomColumns(200000, 64, 2000, generator);
+
+  sparse_matrix_multiplication_stl::SparseMatrix product;
+  ppc::sparse::MeasureKernel([&] { product = first.MultiplyInner(second); }, 10);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_inner_product_gustavson_run) {
+  std::mt19937 generator(15);
+  auto first = sparse_matrix_multiplication_stl::SparseMatrix::ComputeTranspose(
+      RandomColumns(200000, 64, 2000, generator));
+  auto second = RandomColumns(200000, 64, 2000, generator);
+
+  sparse_matrix_multiplication_stl::SparseMatrix product;
+  ppc::sparse::MeasureKernel([&] { product = first * second; }, 10);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_masked_run) {
+  const auto size = 600;
+
+  // A sampled product: one entry in a hundred of C is wanted, so the full product mostly computes what gets thrown
+  // away.
+  auto matrixA = sparse_matrix_multiplication_stl::GenerateRandomMatrix(size * size);
+  auto matrixB = sparse_matrix_multiplication_stl::GenerateRandomMatrix(size * size);
+  std::vector<double> matrixM(size * size, 0);
+  std::mt19937 generator(16);
+  for (auto& value : matrixM) value = generator() % 100 == 0 ? 1 : 0;
+  auto mask = sparse_matrix_multiplication_stl::MatrixToSparse(size, size, matrixM);
+  std::vector<double> mask_values(mask.GetValues().begin(), mask.GetValues().end());
+  std::vector<int> mask_rows(mask.GetRowIndices().begin(), mask.GetRowIndices().end());
+  std::vector<int> mask_cumulative(mask.GetCumulativeElements().begin(), mask.GetCumulativeElements().end());
+  std::vector<double> result(size * size, 0);
+
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs = {reinterpret_cast<uint8_t*>(matrixA.data()), reinterpret_cast<uint8_t*>(matrixB.data()),
+                       reinterpret_cast<uint8_t*>(mask_values.data()), reinterpret_cast<uint8_t*>(mask_rows.data()),
+                       reinterpret_cast<uint8_t*>(mask_cumulative.data())};
+  task_data->inputs_count = {size, size, size, size, static_cast<uint32_t>(mask_values.size())};
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(result.data()));
+  task_data->outputs_count.emplace_back(result.size());
+
+  ppc::sparse::MeasurePerf(std::make_shared<sparse_matrix_multiplication_stl::CCSMatrixSTL>(task_data), 10);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_block_ccs_run) {
+  auto matrix = BlockOperator(10000, 6);
+
+  sparse_matrix_multiplication_stl::SparseMatrix product;
+  ppc::sparse::MeasureKernel([&] { product = matrix * matrix; }, 3);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_block_multiply_run) {
+  auto blocks = sparse_matrix_multiplication_stl::BlockSparseMatrix::FromSparse(BlockOperator(10000, 6), 6);
+
+  sparse_matrix_multiplication_stl::BlockSparseMatrix product;
+  ppc::sparse::MeasureKernel([&] { product = blocks * blocks; }, 3);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_generate_uniform_run) {
+  const int size = 1 << 18;
+
+  sparse_matrix_multiplication_stl::SparseMatrix matrix;
+  ppc::sparse::MeasureKernel(
+      [&] { matrix = sparse_matrix_multiplication_stl::GenerateUniform(size, size, 16.0 / size, 20); }, 3);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_generate_rmat_run) {
+  sparse_matrix_multiplication_stl::SparseMatrix matrix;
+  ppc::sparse::MeasureKernel(
+      [&] { matrix = sparse_matrix_multiplication_stl::GenerateRMat(18, 16.0 / (1 << 18), 20); }, 3);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_rmat_square_run) {
+  // The skewed columns of a power-law pattern are the case the cost-based column partitioning is for.
+  auto graph = sparse_matrix_multiplication_stl::GenerateRMat(14, 8.0 / (1 << 14), 20);
+
+  sparse_matrix_multiplication_stl::SparseMatrix product;
+  ppc::sparse::MeasureKernel([&] { product = graph * graph; }, 3);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_matrix_to_sparse_run) {
+  const auto size = 2000;
+  auto matrix = sparse_matrix_multiplication_stl::GenerateRandomMatrix(size * size);
+
+  sparse_matrix_multiplication_stl::SparseMatrix sparse;
+  ppc::sparse::MeasureKernel(
+      [&] { sparse = sparse_matrix_multiplication_stl::MatrixToSparse(size, size, matrix); }, 10);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_ccs_pipeline_run) {
+  const auto size = 1000;
+
+  // Row-major input all the way: the pipeline compresses, multiplies and expands.
+  auto matrixA = sparse_matrix_multiplication_stl::GenerateRandomMatrix(size * size);
+  auto matrixB = sparse_matrix_multiplication_stl::GenerateRandomMatrix(size * size);
+  std::vector<double> result(size * size, 0);
+
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs = {reinterpret_cast<uint8_t*>(matrixA.data()), reinterpret_cast<uint8_t*>(matrixB.data())};
+  task_data->inputs_count = {size, size, size, size};
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(result.data()));
+  task_data->outputs_count.emplace_back(result.size());
+
+  ppc::sparse::MeasurePerf(std::make_shared<sparse_matrix_multiplication_stl::CCSMatrixSTL>(task_data), 5,
+                           ppc::core::PerfResults::kPipeline);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_csr_pipeline_run) {
+  const auto size = 1000;
+
+  auto matrixA = sparse_matrix_multiplication_stl::GenerateRandomMatrix(size * size);
+  auto matrixB = sparse_matrix_multiplication_stl::GenerateRandomMatrix(size * size);
+  std::vector<double> result(size * size, 0);
+
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs = {reinterpret_cast<uint8_t*>(matrixA.data()), reinterpret_cast<uint8_t*>(matrixB.data())};
+  task_data->inputs_count = {size, size, size, size};
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(result.data()));
+  task_data->outputs_count.emplace_back(result.size());
+
+  const auto layout = sparse_matrix_multiplication_stl::SparseLayout::kCsr;
+  ppc::sparse::MeasurePerf(std::make_shared<sparse_matrix_multiplication_stl::CCSMatrixSTL>(task_data, layout), 5,
+                           ppc::core::PerfResults::kPipeline);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_drop_policy_full_run) {
+  // A^4 by repeated squaring of a banded matrix, the way fill grows across multigrid levels.
+  auto matrix = sparse_matrix_multiplication_stl::GenerateBanded(20000, 6, 6, 0.5, 17);
+
+  sparse_matrix_multiplication_stl::SparseMatrix product;
+  ppc::sparse::MeasureKernel(
+      [&] {
+        auto square = matrix * matrix;
+        product = square * square;
+      },
+      10);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_drop_policy_top_k_run) {
+  // The same A^4 keeping the 8 largest entries per column of every product.
+  auto matrix = sparse_matrix_multiplication_stl::GenerateBanded(20000, 6, 6, 0.5, 17);
+  const sparse_matrix_multiplication_stl::DropPolicy drop{.top_k = 8};
+
+  sparse_matrix_multiplication_stl::SparseMatrix product;
+  ppc::sparse::MeasureKernel(
+      [&] {
+        auto square = matrix.Multiply(matrix, drop);
+        product = square.Multiply(square, drop);
+      },
+      10);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_chain_pairwise_run) {
+  auto operands = GalerkinOperands(40000);
+
+  sparse_matrix_multiplication_stl::SparseMatrix product;
+  ppc::sparse::MeasureKernel([&] { product = (operands[0] * operands[1]) * operands[2]; }, 10);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_chain_cold_run) {
+  auto operands = GalerkinOperands(40000);
+
+  sparse_matrix_multiplication_stl::SparseMatrix product;
+  ppc::sparse::MeasureKernel(
+      [&] { product = sparse_matrix_multiplication_stl::ChainPlan(operands).Multiply(operands); }, 10);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_chain_run) {
+  auto operands = GalerkinOperands(40000);
+  sparse_matrix_multiplication_stl::ChainPlan plan(operands);
+
+  sparse_matrix_multiplication_stl::SparseMatrix product;
+  ppc::sparse::MeasureKernel([&] { product = plan.Multiply(operands); }, 10);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_write_matrix_market_run) {
+  auto matrix = RandomSparse(1000);
+  auto path = (std::filesystem::temp_directory_path() / "sparse_matrix_stl_perf_write.mtx").string();
+
+  ppc::sparse::MeasureKernel([&] { sparse_matrix_multiplication_stl::WriteMatrixMarket(path, matrix); }, 5);
+  std::filesystem::remove(path);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_matrix_market_run) {
+  auto matrix = RandomSparse(1000);
+  auto path = (std::filesystem::temp_directory_path() / "sparse_matrix_stl_perf.mtx").string();
+  sparse_matrix_multiplication_stl::WriteMatrixMarket(path, matrix);
+
+  sparse_matrix_multiplication_stl::SparseMatrix restored;
+  ppc::sparse::MeasureKernel([&] { restored = sparse_matrix_multiplication_stl::ReadMatrixMarket(path); }, 10);
+  std::filesystem::remove(path);
+}
+
+TEST(sparse_matrix_multiplication_stl, test_binary_ccs_run) {
+  auto matrix = RandomSparse(1000);
+  auto path = (std::filesystem::temp_directory_path() / "sparse_matrix_stl_perf.ccs").string();
+  sparse_matrix_multiplication_stl::WriteBinaryCCS(path, matrix);
+
+  sparse_matrix_multiplication_stl::SparseMatrix mapped;
+  ppc::sparse::MeasureKernel([&] { mapped = sparse_matrix_multiplication_stl::MapBinaryCCS(path); }, 10);
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "stl/sparse_matrix/include/sparse_matrix_stl.hpp"
+#include "sparse/task/include/spmm_task.hpp"
+
+// Compiled once for this policy in spmv_stl.cpp.
+extern template class ppc::sparse::SpMMTask<ppc::sparse::ThreadPoolPolicy>;
+
+namespace sparse_matrix_vector_multiplication_stl {
+
+using sparse_matrix_multiplication_stl::BasicSparseMatrix;
+using sparse_matrix_multiplication_stl::Policy;
+
+using ppc::sparse::kVectorBlock;
+using ppc::sparse::MultiplyCcs;
+using ppc::sparse::MultiplyCsr;
+using ppc::sparse::SparseLayout;
+
+class SpMMSTL final : public ppc::sparse::SpMMTask<Policy> {
+ public:
+  using SpMMTask::SpMMTask;
+};
+
+}  // namespace sparse_matrix_vector_multiplication_stl
@@ -0,0 +1,3 @@
+#include "stl/sparse_matrix_vector/include/spmv_stl.hpp"
+
+template class ppc::sparse::SpMMTask<ppc::sparse::ThreadPoolPolicy>;
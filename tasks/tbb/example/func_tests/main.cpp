@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/util/include/dense_gemm.hpp"
 #include "core/util/include/util.hpp"
 #include "tbb/example/include/ops_tbb.hpp"
 
@@ -71,3 +72,30 @@ TEST(nesterov_a_test_task_tbb, test_matmul_100_from_file) {
   test_task_tbb.PostProcessing();
   EXPECT_EQ(in, out);
 }
+
+TEST(nesterov_a_test_task_tbb, test_matmul_70_matches_reference) {
+  constexpr int kCount = 70;
+
+  // Create data
+  std::vector<int> in(kCount * kCount, 0);
+  std::vector<int> out(kCount * kCount, 0);
+
+  for (size_t i = 0; i < in.size(); i++) {
+    in[i] = static_cast<int>(((i * 7) + 3) % 11) - 5;
+  }
+
+  // Create task_data
+  auto task_data_tbb = std::make_shared<ppc::core::TaskData>();
+  task_data_tbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data_tbb->inputs_count.emplace_back(in.size());
+  task_data_tbb->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data_tbb->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  nesterov_a_test_task_tbb::TestTaskTBB test_task_tbb(task_data_tbb);
+  ASSERT_EQ(test_task_tbb.Validation(), true);
+  test_task_tbb.PreProcessing();
+  test_task_tbb.Run();
+  test_task_tbb.PostProcessing();
+  EXPECT_EQ(out, ppc::util::MultiplyDense(in, in, kCount, kCount, kCount));
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "tbb/sparse_matrix/include/sparse_matrix_tbb.hpp"
+#include "sparse/task/include/spmm_task.hpp"
+
+// Compiled once for this policy in spmv_tbb.cpp.
+extern template class ppc::sparse::SpMMTask<ppc::sparse::TbbPolicy>;
+
+namespace sparse_matrix_vector_multiplication_tbb {
+
+using sparse_matrix_multiplication_tbb::BasicSparseMatrix;
+using sparse_matrix_multiplication_tbb::Policy;
+
+using ppc::sparse::kVectorBlock;
+using ppc::sparse::MultiplyCcs;
+using ppc::sparse::MultiplyCsr;
+using ppc::sparse::SparseLayout;
+
+class SpMMTBB final : public ppc::sparse::SpMMTask<Policy> {
+ public:
+  using SpMMTask::SpMMTask;
+};
+
+}  // namespace sparse_matrix_vector_multiplication_tbb
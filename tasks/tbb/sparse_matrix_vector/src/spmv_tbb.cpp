@@ -0,0 +1,3 @@
+#include "tbb/sparse_matrix_vector/include/spmv_tbb.hpp"
+
+template class ppc::sparse::SpMMTask<ppc::sparse::TbbPolicy>;